@@ -0,0 +1,55 @@
+#pragma once
+
+#include <ui_core/ControlId.h>
+#include "parameters/Parameters.h"
+
+//==============================================================================
+// Stable ControlIds: public contract between UI, hardware and session state.
+// See docs/CONTROL_IDS.md before adding or changing anything here.
+
+// Core (1000–1099)
+constexpr ui_core::ControlId kGainControlId   = 1001;
+constexpr ui_core::ControlId kOutputControlId = 1002;
+constexpr ui_core::ControlId kMixControlId    = 1003;
+
+// Dynamics (1100–1199)
+constexpr ui_core::ControlId kDuckThresholdControlId = 1101;
+constexpr ui_core::ControlId kDuckDepthControlId     = 1102;
+
+//==============================================================================
+/** One user-facing control. Range, name and unit come from
+    Parameters::getSpec (parameter); this only adds what the UI and the
+    hardware backends need on top. */
+struct ControlInfo
+{
+    ui_core::ControlId id;
+    Parameters::Index parameter;
+    const char* oscAddress;     // absolute 0..1; "<address>/delta" is relative
+    float interval;             // UI step, native units
+};
+
+/** Every control, in focus (Tab) and layout order. MainView, bindings and
+    OSC addresses are generated from this table: adding a control is one line. */
+inline constexpr ControlInfo kControls[] =
+{
+    { kGainControlId,          Parameters::gainIndex,          "/gain",          0.01f },
+    { kOutputControlId,        Parameters::outputGainIndex,    "/output",        0.01f },
+    { kMixControlId,           Parameters::mixIndex,           "/mix",           0.01f },
+    { kDuckThresholdControlId, Parameters::duckThresholdIndex, "/duck/threshold", 0.1f },
+    { kDuckDepthControlId,     Parameters::duckDepthIndex,     "/duck/depth",     0.1f },
+};
+
+constexpr int kNumControls = static_cast<int> (sizeof (kControls) / sizeof (kControls[0]));
+
+//==============================================================================
+/** Host parameter a control writes to, or -1 for an id not in kControls.
+    Every control has one, so a real-time source (MIDI) may write any of
+    them straight from the audio thread. */
+inline int getHostParameterIndex (ui_core::ControlId controlId) noexcept
+{
+    for (const auto& control : kControls)
+        if (control.id == controlId)
+            return control.parameter;
+
+    return -1;
+}
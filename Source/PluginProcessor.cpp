@@ -1,13 +1,48 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "debug/RealtimeGuard.h"
+#include "ControlIds.h"
 
 //==============================================================================
 PluginTemplateAudioProcessor::PluginTemplateAudioProcessor()
+    : AudioProcessor (BusesProperties()
+                          .withInput  ("Input",     juce::AudioChannelSet::stereo(), true)
+                          .withOutput ("Output",    juce::AudioChannelSet::stereo(), true)
+                          .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false))
 {
+    parameters.createHostParameters (*this);
+
+    // Hands audio-thread control changes over to the message thread
+    startTimerHz (30);
 }
 
 PluginTemplateAudioProcessor::~PluginTemplateAudioProcessor()
 {
+    stopTimer();
+}
+
+ControlSurface& PluginTemplateAudioProcessor::getControlSurface()
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    // The first timer tick at the latest, so hardware works without an editor
+    if (controlSurface == nullptr)
+        controlSurface = std::make_unique<ControlSurface> (parameters);
+
+    return *controlSurface;
+}
+
+void PluginTemplateAudioProcessor::timerCallback()
+{
+    // MIDI moves: host notification, gestures and undo, then LEDs and editor
+    const auto movedByMidi = parameters.flushHostNotifications();
+    midiDecoder.applyLearnedMapping();
+
+    auto& surface = getControlSurface();
+    surface.parametersChanged (movedByMidi);
+
+    // Focus recalled with the session arrives through Parameters
+    surface.syncFocusFromParameters();
 }
 
 //==============================================================================
@@ -77,11 +112,49 @@ void PluginTemplateAudioProcessor::changeProgramName (int index, const juce::Str
 //==============================================================================
 void PluginTemplateAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused (sampleRate, samplesPerBlock);
+    // With a fixed internal block size the DSP core never sees anything else
+    int coreBlockSize = samplesPerBlock;
+    int reblockLatency = 0;
+
+    if (kInternalBlockSize > 0)
+    {
+        fixedBlocks.prepare (juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), kInternalBlockSize);
+        coreBlockSize = fixedBlocks.getBlockSize();
+        reblockLatency = fixedBlocks.getLatencySamples();
+    }
+
+    gainStages.get<GainRampStage>().prepare (sampleRate);
+    ducker.prepare (sampleRate, coreBlockSize);
+    limiter.prepare (sampleRate, coreBlockSize, getMainBusNumOutputChannels());
+    spectrumAnalyzer.prepare (sampleRate);
+
+    // Constant while playing: the limiter delays even when switched off.
+    const auto totalLatency = reblockLatency + limiter.getLatencySamples();
+    setLatencySamples (totalLatency);
+
+    // The dry path is delayed by exactly what the wet path reports
+    dryWetMixer.prepare (sampleRate, samplesPerBlock, getMainBusNumOutputChannels(), totalLatency);
 }
 
 void PluginTemplateAudioProcessor::releaseResources()
 {
+    // Only non-empty when built with PLUGIN_REALTIME_CHECKS. Release builds
+    // and hosts without a debugger still leave a report in the log folder.
+    if (const int numViolations = RealtimeGuard::getNumViolations(); numViolations > 0)
+    {
+        const auto reportFile = juce::FileLogger::getSystemLogFileFolder()
+                                    .getChildFile (JucePlugin_Name)
+                                    .getChildFile ("RealtimeViolations.log");
+        reportFile.getParentDirectory().createDirectory();
+
+        const bool saved = RealtimeGuard::appendReportTo (reportFile);
+        juce::Logger::writeToLog (juce::String (numViolations) + " allocations/locks inside processBlock; "
+                                  + (saved ? "report appended to " + reportFile.getFullPathName()
+                                           : RealtimeGuard::getReport()));
+        jassertfalse;   // something allocated or locked inside processBlock
+
+        RealtimeGuard::clear();
+    }
 }
 
 bool PluginTemplateAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -94,14 +167,18 @@ bool PluginTemplateAudioProcessor::isBusesLayoutSupported (const BusesLayout& la
     if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
         return false;
 
-    return true;
+    // Optional sidechain: off, mono or stereo
+    const auto sidechain = layouts.getChannelSet (true, 1);
+    return sidechain.isDisabled()
+        || sidechain == juce::AudioChannelSet::mono()
+        || sidechain == juce::AudioChannelSet::stereo();
 }
 
 void PluginTemplateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
-    juce::ignoreUnused (midiMessages);
-
+    RealtimeGuard::ScopedAudioContext audioContext;
     juce::ScopedNoDenormals noDenormals;
+
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
@@ -109,13 +186,96 @@ void PluginTemplateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    // Apply gain
-    const auto gainValue = parameters.getGain();
-    if (gainValue != 1.0f)
+    // MIDI CC / NRPN control input. Changes take effect at their sample
+    // position: the block is split there, so everything before it still
+    // runs with the previous value. With kInternalBlockSize only the mix
+    // stays that exact; processCore() reads the other parameters once per
+    // internal block, so they switch at the start of the block the event
+    // falls into (up to one internal block early).
+    const int numSamples = buffer.getNumSamples();
+    int segmentStart = 0;
+
+    midiDecoder.process (midiMessages, [&] (int samplePosition, const ui_core::HardwareControlEvent& event)
+    {
+        // -1 only for a mapping recalled from a build with other controls
+        const auto index = getHostParameterIndex (event.controlId);
+        if (index < 0)
+            return;
+
+        const auto position = juce::jlimit (segmentStart, numSamples, samplePosition);
+        if (position > segmentStart)
+        {
+            processSegment (buffer, segmentStart, position - segmentStart);
+            segmentStart = position;
+        }
+
+        parameters.setNormalisedFromAudioThread (static_cast<Parameters::Index> (index), event.normalizedValue);
+    });
+
+    if (segmentStart < numSamples)
+        processSegment (buffer, segmentStart, numSamples - segmentStart);
+}
+
+void PluginTemplateAudioProcessor::processSegment (juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept
+{
+    // A view of the same channels; no copy, no allocation up to 32 channels
+    juce::AudioBuffer<float> segment (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), startSample, numSamples);
+
+    const auto numMainChannels = getMainBusNumOutputChannels();
+
+    // Dry captured before, blended after; chunked if the host sends more
+    // than prepareToPlay() promised
+    dryWetMixer.process (segment, numMainChannels, parameters.getMix(), [this] (juce::AudioBuffer<float>& wet)
+    {
+        if (kInternalBlockSize > 0)
+            fixedBlocks.process (wet, [this] (juce::AudioBuffer<float>& block) { processCore (block); });
+        else
+            processCore (wet);
+    });
+
+    // Analyzer tap: a FIFO copy only, and only while a view is open
+    spectrumAnalyzer.pushSamples (segment, numMainChannels);
+}
+
+void PluginTemplateAudioProcessor::processCore (juce::AudioBuffer<float>& buffer) noexcept
+{
+    const auto numMainChannels = getMainBusNumOutputChannels();
+    const auto sidechain = getBusBuffer (buffer, true, 1);
+    const auto duckDepth = parameters.getDuckDepth();
+
+    // Gain and output gain as one smoothed scalar
+    auto& gainRamp = gainStages.get<GainRampStage>();
+    gainRamp.setTarget (parameters.getGain() * parameters.getOutputGain());
+
+    const int maxChunk = ducker.getMaximumBlockSize();
+
+    if (SidechainDucker::isActive (sidechain, duckDepth) && maxChunk > 0)
     {
-        for (int channel = 0; channel < totalNumInputChannels; ++channel)
-            buffer.applyGain (channel, 0, buffer.getNumSamples(), gainValue);
+        const int numSamples = buffer.getNumSamples();
+        for (int start = 0; start < numSamples; start += maxChunk)
+        {
+            const int count = juce::jmin (maxChunk, numSamples - start);
+
+            // Barrier: the ducking curve needs the whole chunk of sidechain
+            gainStages.get<GainCurveStage>().setCurve (
+                ducker.computeGainCurve (sidechain, start, count, parameters.getDuckThreshold(), duckDepth));
+
+            // Fused: ramp x curve in one pass per channel
+            gainStages.process (buffer, numMainChannels, start, count);
+        }
     }
+    else
+    {
+        // Start from silence next time ducking comes back
+        ducker.reset();
+
+        // No curve to apply: the ramp alone, or nothing at settled unity
+        if (! gainRamp.isUnity())
+            gainStages.processOnly<GainRampStage> (buffer, numMainChannels, 0, buffer.getNumSamples());
+    }
+
+    // Barrier: output stage; output gain can reach +6 dB, so catch overs here
+    limiter.process (buffer, numMainChannels, parameters.getLimiterEnabled());
 }
 
 //==============================================================================
@@ -132,17 +292,34 @@ juce::AudioProcessorEditor* PluginTemplateAudioProcessor::createEditor()
 //==============================================================================
 void PluginTemplateAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    juce::ValueTree state ("PluginState");
-    parameters.getState (state);
-    juce::MemoryOutputStream mos (destData, true);
-    state.writeToStream (mos);
+    // Hosts poll this for autosave/undo; only rebuild when something changed.
+    const juce::ScopedLock sl (cachedStateLock);
+
+    const bool parametersChanged = parameters.consumeStateChange();
+    const bool mappingsChanged = midiDecoder.consumeMappingChange();
+
+    if (parametersChanged || mappingsChanged || cachedState.isEmpty())
+    {
+        juce::ValueTree state ("PluginState");
+        parameters.getState (state);
+        midiDecoder.getState (state);
+
+        cachedState.reset();
+        juce::MemoryOutputStream mos (cachedState, false);
+        state.writeToStream (mos);
+    }
+
+    destData.append (cachedState.getData(), cachedState.getSize());
 }
 
 void PluginTemplateAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     auto tree = juce::ValueTree::readFromData (data, static_cast<size_t> (sizeInBytes));
     if (tree.isValid())
+    {
         parameters.setState (tree);
+        midiDecoder.setState (tree);
+    }
 }
 
 // ADD — Source/PluginProcessor.cpp (very bottom, after all code)
@@ -2,13 +2,26 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "parameters/Parameters.h"
+#include "dsp/DryWetMixer.h"
+#include "dsp/FixedBlockAdapter.h"
+#include "dsp/GainStages.h"
+#include "dsp/LookAheadLimiter.h"
+#include "dsp/SidechainDucker.h"
+#include "dsp/SpectrumAnalyzer.h"
+#include "hardware/ControlSurface.h"
+#include "hardware/MidiControlDecoder.h"
+
+#ifndef PLUGIN_INTERNAL_BLOCK_SIZE
+ #define PLUGIN_INTERNAL_BLOCK_SIZE 0
+#endif
 
 //==============================================================================
 /**
     Audio Processor Template.
     Replace this with your plugin's audio processing logic.
 */
-class PluginTemplateAudioProcessor : public juce::AudioProcessor
+class PluginTemplateAudioProcessor : public juce::AudioProcessor,
+                                     private juce::Timer
 {
 public:
     //==============================================================================
@@ -51,9 +64,52 @@ public:
     Parameters& getParameters() { return parameters; }
     const Parameters& getParameters() const { return parameters; }
 
+    //==============================================================================
+    MidiControlDecoder& getMidiControlDecoder() { return midiDecoder; }
+    SpectrumAnalyzer& getSpectrumAnalyzer() { return spectrumAnalyzer; }
+    SidechainDucker& getSidechainDucker() { return ducker; }
+
+    /** Bindings, focus and hardware I/O; outlives any editor. Message thread
+        only: created on first use there, not in the constructor. */
+    ControlSurface& getControlSurface();
+
 private:
     //==============================================================================
+    void timerCallback() override;
+
+    /** Dry/wet, DSP and analyzer tap for one stretch of the host block between
+        MIDI controller changes. */
+    void processSegment (juce::AudioBuffer<float>& buffer, int startSample, int numSamples) noexcept;
+
+    /** Everything after input handling; runs on host-sized or fixed-size blocks. */
+    void processCore (juce::AudioBuffer<float>& buffer) noexcept;
+
+    // 0 = process host blocks as they come. Otherwise MIDI parameter changes
+    // land on internal-block boundaries (see processBlock)
+    static constexpr int kInternalBlockSize = PLUGIN_INTERNAL_BLOCK_SIZE;
+
     Parameters parameters;
+    FixedBlockAdapter fixedBlocks;
+
+    // Per-sample stages after the gain, fused into one loop per channel.
+    // Block-level stages (ducker, limiter) run between fused groups.
+    FusedStages<GainRampStage, GainCurveStage> gainStages;
+    SidechainDucker ducker;
+    LookAheadLimiter limiter;
+    DryWetMixer dryWetMixer;
+    SpectrumAnalyzer spectrumAnalyzer;
+
+    // MIDI controller input: decoded and applied on the audio thread; the
+    // timer catches up on gestures, undo and feedback
+    MidiControlDecoder midiDecoder;
+
+    // Hosts may construct plugins off the message thread; the ui_core objects
+    // inside claim whichever thread touches them first
+    std::unique_ptr<ControlSurface> controlSurface;
+
+    // Last serialized state, reused while Parameters reports no change
+    juce::MemoryBlock cachedState;
+    juce::CriticalSection cachedStateLock;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginTemplateAudioProcessor)
 };
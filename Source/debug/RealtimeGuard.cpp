@@ -0,0 +1,568 @@
+#include "RealtimeGuard.h"
+
+#if PLUGIN_REALTIME_CHECKS
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if JUCE_LINUX || JUCE_MAC
+ #include <dlfcn.h>
+ #include <execinfo.h>
+ #include <pthread.h>
+ #define PLUGIN_REALTIME_CHECKS_POSIX 1
+#else
+ #define PLUGIN_REALTIME_CHECKS_POSIX 0
+#endif
+
+#if JUCE_WINDOWS
+ #include <malloc.h>
+#endif
+
+// Static TLS: dynamic TLS in a dlopen'ed plugin allocates on first access,
+// which would re-enter the malloc hook.
+#if JUCE_LINUX
+ #define PLUGIN_REALTIME_TLS __attribute__ ((tls_model ("initial-exec")))
+#else
+ #define PLUGIN_REALTIME_TLS
+#endif
+
+namespace
+{
+    constexpr int kMaxViolations = 64;
+    constexpr int kMaxFrames = 32;
+
+    struct Violation
+    {
+        const char* what = nullptr;
+        void* frames[kMaxFrames] {};
+        int numFrames = 0;
+        std::atomic<bool> complete { false };
+    };
+
+    std::array<Violation, kMaxViolations> violations;
+    std::atomic<int> numViolations { 0 };
+
+    thread_local bool inAudioContext PLUGIN_REALTIME_TLS = false;
+    thread_local bool inReport PLUGIN_REALTIME_TLS = false;   // backtrace() may itself allocate or lock
+
+   #if PLUGIN_REALTIME_CHECKS_POSIX
+    // The first backtrace() call can load the unwinder; get that out of the
+    // way before any audio thread runs.
+    [[maybe_unused]] const int unwinderWarmUp = []
+    {
+        void* frame = nullptr;
+        return backtrace (&frame, 1);
+    }();
+   #endif
+}
+
+//==============================================================================
+RealtimeGuard::ScopedAudioContext::ScopedAudioContext() noexcept
+    : previous (inAudioContext)
+{
+    inAudioContext = true;
+}
+
+RealtimeGuard::ScopedAudioContext::~ScopedAudioContext() noexcept
+{
+    inAudioContext = previous;
+}
+
+bool RealtimeGuard::isAudioContext() noexcept
+{
+    return inAudioContext && ! inReport;
+}
+
+void RealtimeGuard::reportViolation (const char* what) noexcept
+{
+    if (! isAudioContext())
+        return;
+
+    inReport = true;
+
+    const int index = numViolations.fetch_add (1);
+    if (index < kMaxViolations)
+    {
+        auto& v = violations[(size_t) index];
+        v.what = what;
+       #if PLUGIN_REALTIME_CHECKS_POSIX
+        v.numFrames = backtrace (v.frames, kMaxFrames);
+       #endif
+        v.complete.store (true, std::memory_order_release);
+    }
+
+    inReport = false;
+}
+
+int RealtimeGuard::getNumViolations() noexcept
+{
+    return numViolations.load();
+}
+
+juce::String RealtimeGuard::getReport()
+{
+    const int total = getNumViolations();
+    if (total == 0)
+        return {};
+
+    juce::String report;
+    report << "Real-time violations on the audio thread: " << total << juce::newLine;
+
+    for (int i = 0; i < juce::jmin (total, kMaxViolations); ++i)
+    {
+        const auto& v = violations[(size_t) i];
+        if (! v.complete.load (std::memory_order_acquire))
+            continue;
+
+        report << "#" << i << " " << v.what << juce::newLine;
+
+       #if PLUGIN_REALTIME_CHECKS_POSIX
+        if (auto** symbols = backtrace_symbols (v.frames, v.numFrames))
+        {
+            for (int f = 0; f < v.numFrames; ++f)
+                report << "    " << symbols[f] << juce::newLine;
+
+            std::free (symbols);
+        }
+       #endif
+    }
+
+    if (total > kMaxViolations)
+        report << "(" << (total - kMaxViolations) << " more not recorded)" << juce::newLine;
+
+    return report;
+}
+
+void RealtimeGuard::clear() noexcept
+{
+    for (auto& v : violations)
+        v.complete.store (false);
+
+    numViolations.store (0);
+}
+
+bool RealtimeGuard::appendReportTo (const juce::File& file)
+{
+    const auto report = getReport();
+    if (report.isEmpty())
+        return false;
+
+    return file.appendText (juce::Time::getCurrentTime().toString (true, true) + juce::newLine + report + juce::newLine);
+}
+
+//==============================================================================
+// The allocator behind the hooks. On Linux the C allocation hooks below
+// replace malloc and free, so operator new/delete go to glibc's own entry
+// points to avoid reporting the same call twice. On macOS the interposed
+// hooks don't apply to calls from this image, so plain malloc/free is fine.
+#if JUCE_LINUX
+extern "C" void* __libc_malloc (std::size_t);
+extern "C" void* __libc_calloc (std::size_t, std::size_t);
+extern "C" void* __libc_realloc (void*, std::size_t);
+extern "C" void  __libc_free (void*);
+#endif
+
+namespace
+{
+    void* rawMalloc (std::size_t size) noexcept
+    {
+       #if JUCE_LINUX
+        return __libc_malloc (size == 0 ? 1 : size);
+       #else
+        return std::malloc (size == 0 ? 1 : size);
+       #endif
+    }
+
+    void rawFree (void* p) noexcept
+    {
+       #if JUCE_LINUX
+        __libc_free (p);
+       #else
+        std::free (p);
+       #endif
+    }
+
+    void* rawAlignedMalloc (std::size_t size, std::align_val_t alignment) noexcept
+    {
+        const auto align = juce::jmax (static_cast<std::size_t> (alignment), sizeof (void*));
+
+       #if JUCE_WINDOWS
+        return _aligned_malloc (size == 0 ? 1 : size, align);
+       #else
+        void* p = nullptr;
+        return posix_memalign (&p, align, size == 0 ? 1 : size) == 0 ? p : nullptr;
+       #endif
+    }
+
+    void rawAlignedFree (void* p) noexcept
+    {
+       #if JUCE_WINDOWS
+        _aligned_free (p);
+       #else
+        rawFree (p);
+       #endif
+    }
+}
+
+//==============================================================================
+// Global allocation hooks
+void* operator new (std::size_t size)
+{
+    RealtimeGuard::reportViolation ("operator new");
+
+    if (auto* p = rawMalloc (size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size)
+{
+    RealtimeGuard::reportViolation ("operator new[]");
+
+    if (auto* p = rawMalloc (size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::reportViolation ("operator new (nothrow)");
+    return rawMalloc (size);
+}
+
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::reportViolation ("operator new[] (nothrow)");
+    return rawMalloc (size);
+}
+
+void operator delete (void* p) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::reportViolation ("operator delete");
+
+    rawFree (p);
+}
+
+void operator delete[] (void* p) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::reportViolation ("operator delete[]");
+
+    rawFree (p);
+}
+
+void operator delete (void* p, std::size_t) noexcept    { operator delete (p); }
+void operator delete[] (void* p, std::size_t) noexcept  { operator delete[] (p); }
+void operator delete (void* p, const std::nothrow_t&) noexcept    { operator delete (p); }
+void operator delete[] (void* p, const std::nothrow_t&) noexcept  { operator delete[] (p); }
+
+//==============================================================================
+// Over-aligned types (alignas > 16), e.g. SIMD buffers
+void* operator new (std::size_t size, std::align_val_t alignment)
+{
+    RealtimeGuard::reportViolation ("operator new (aligned)");
+
+    if (auto* p = rawAlignedMalloc (size, alignment))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment)
+{
+    RealtimeGuard::reportViolation ("operator new[] (aligned)");
+
+    if (auto* p = rawAlignedMalloc (size, alignment))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void* operator new (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::reportViolation ("operator new (aligned, nothrow)");
+    return rawAlignedMalloc (size, alignment);
+}
+
+void* operator new[] (std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    RealtimeGuard::reportViolation ("operator new[] (aligned, nothrow)");
+    return rawAlignedMalloc (size, alignment);
+}
+
+void operator delete (void* p, std::align_val_t) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::reportViolation ("operator delete (aligned)");
+
+    rawAlignedFree (p);
+}
+
+void operator delete[] (void* p, std::align_val_t) noexcept
+{
+    if (p != nullptr)
+        RealtimeGuard::reportViolation ("operator delete[] (aligned)");
+
+    rawAlignedFree (p);
+}
+
+void operator delete (void* p, std::size_t, std::align_val_t a) noexcept    { operator delete (p, a); }
+void operator delete[] (void* p, std::size_t, std::align_val_t a) noexcept  { operator delete[] (p, a); }
+void operator delete (void* p, std::align_val_t a, const std::nothrow_t&) noexcept    { operator delete (p, a); }
+void operator delete[] (void* p, std::align_val_t a, const std::nothrow_t&) noexcept  { operator delete[] (p, a); }
+
+//==============================================================================
+// C allocation and lock hooks. std::mutex, std::shared_mutex,
+// std::condition_variable, juce::CriticalSection, juce::WaitableEvent and
+// friends all end up in one of these.
+#if JUCE_LINUX
+namespace
+{
+    /** The next definition of a libc/libpthread function, looked up on first
+        use. Namespace-scope and constant-initialised: a function-local static's
+        init guard could itself lock a mutex and recurse into these hooks.
+    */
+    template <typename Fn>
+    class RealFunction
+    {
+    public:
+        constexpr RealFunction (const char* symbolName, const char* symbolVersion = nullptr) noexcept
+            : name (symbolName), version (symbolVersion) {}
+
+        Fn get() noexcept
+        {
+            auto fn = resolved.load (std::memory_order_relaxed);
+            if (fn == nullptr)
+            {
+                // pthread_cond_* keep a pre-2.3.2 ABI under the same name;
+                // plain dlsym can hand back that one.
+                void* symbol = version != nullptr ? dlvsym (RTLD_NEXT, name, version) : nullptr;
+                if (symbol == nullptr)
+                    symbol = dlsym (RTLD_NEXT, name);
+
+                fn = reinterpret_cast<Fn> (symbol);
+                resolved.store (fn, std::memory_order_relaxed);
+            }
+
+            return fn;
+        }
+
+    private:
+        const char* name;
+        const char* version;
+        std::atomic<Fn> resolved { nullptr };
+    };
+
+    using MutexFn       = int (*) (pthread_mutex_t*);
+    using RwLockFn      = int (*) (pthread_rwlock_t*);
+    using CondWaitFn    = int (*) (pthread_cond_t*, pthread_mutex_t*);
+    using CondTimedFn   = int (*) (pthread_cond_t*, pthread_mutex_t*, const timespec*);
+
+    RealFunction<MutexFn> realMutexLock       { "pthread_mutex_lock" };
+    RealFunction<MutexFn> realMutexTryLock    { "pthread_mutex_trylock" };
+    RealFunction<RwLockFn> realRdLock         { "pthread_rwlock_rdlock" };
+    RealFunction<RwLockFn> realWrLock         { "pthread_rwlock_wrlock" };
+    RealFunction<RwLockFn> realTryRdLock      { "pthread_rwlock_tryrdlock" };
+    RealFunction<RwLockFn> realTryWrLock      { "pthread_rwlock_trywrlock" };
+    RealFunction<CondWaitFn> realCondWait     { "pthread_cond_wait", "GLIBC_2.3.2" };
+    RealFunction<CondTimedFn> realCondTimed   { "pthread_cond_timedwait", "GLIBC_2.3.2" };
+}
+
+extern "C" void* malloc (std::size_t size)
+{
+    RealtimeGuard::reportViolation ("malloc");
+    return __libc_malloc (size);
+}
+
+extern "C" void* calloc (std::size_t count, std::size_t size)
+{
+    RealtimeGuard::reportViolation ("calloc");
+    return __libc_calloc (count, size);
+}
+
+extern "C" void* realloc (void* p, std::size_t size)
+{
+    RealtimeGuard::reportViolation ("realloc");
+    return __libc_realloc (p, size);
+}
+
+extern "C" void free (void* p)
+{
+    if (p != nullptr)
+        RealtimeGuard::reportViolation ("free");
+
+    __libc_free (p);
+}
+
+extern "C" int pthread_mutex_lock (pthread_mutex_t* mutex)
+{
+    RealtimeGuard::reportViolation ("pthread_mutex_lock");
+    return realMutexLock.get() (mutex);
+}
+
+extern "C" int pthread_mutex_trylock (pthread_mutex_t* mutex)
+{
+    RealtimeGuard::reportViolation ("pthread_mutex_trylock");
+    return realMutexTryLock.get() (mutex);
+}
+
+extern "C" int pthread_rwlock_rdlock (pthread_rwlock_t* lock)
+{
+    RealtimeGuard::reportViolation ("pthread_rwlock_rdlock");
+    return realRdLock.get() (lock);
+}
+
+extern "C" int pthread_rwlock_wrlock (pthread_rwlock_t* lock)
+{
+    RealtimeGuard::reportViolation ("pthread_rwlock_wrlock");
+    return realWrLock.get() (lock);
+}
+
+extern "C" int pthread_rwlock_tryrdlock (pthread_rwlock_t* lock)
+{
+    RealtimeGuard::reportViolation ("pthread_rwlock_tryrdlock");
+    return realTryRdLock.get() (lock);
+}
+
+extern "C" int pthread_rwlock_trywrlock (pthread_rwlock_t* lock)
+{
+    RealtimeGuard::reportViolation ("pthread_rwlock_trywrlock");
+    return realTryWrLock.get() (lock);
+}
+
+extern "C" int pthread_cond_wait (pthread_cond_t* cond, pthread_mutex_t* mutex)
+{
+    RealtimeGuard::reportViolation ("pthread_cond_wait");
+    return realCondWait.get() (cond, mutex);
+}
+
+extern "C" int pthread_cond_timedwait (pthread_cond_t* cond, pthread_mutex_t* mutex, const timespec* time)
+{
+    RealtimeGuard::reportViolation ("pthread_cond_timedwait");
+    return realCondTimed.get() (cond, mutex, time);
+}
+
+#if __GLIBC_PREREQ(2, 30)
+// libstdc++ uses this for steady_clock waits (condition_variable::wait_for)
+namespace
+{
+    using CondClockFn = int (*) (pthread_cond_t*, pthread_mutex_t*, clockid_t, const timespec*);
+    RealFunction<CondClockFn> realCondClock { "pthread_cond_clockwait" };
+}
+
+extern "C" int pthread_cond_clockwait (pthread_cond_t* cond, pthread_mutex_t* mutex, clockid_t clock, const timespec* time)
+{
+    RealtimeGuard::reportViolation ("pthread_cond_clockwait");
+    return realCondClock.get() (cond, mutex, clock, time);
+}
+#endif
+
+#elif JUCE_MAC
+namespace
+{
+    // Calls from this image aren't interposed, so these reach the originals
+    void* checkedMalloc (std::size_t size)
+    {
+        RealtimeGuard::reportViolation ("malloc");
+        return malloc (size);
+    }
+
+    void* checkedCalloc (std::size_t count, std::size_t size)
+    {
+        RealtimeGuard::reportViolation ("calloc");
+        return calloc (count, size);
+    }
+
+    void* checkedRealloc (void* p, std::size_t size)
+    {
+        RealtimeGuard::reportViolation ("realloc");
+        return realloc (p, size);
+    }
+
+    void checkedFree (void* p)
+    {
+        if (p != nullptr)
+            RealtimeGuard::reportViolation ("free");
+
+        free (p);
+    }
+
+    int checkedMutexLock (pthread_mutex_t* mutex)
+    {
+        RealtimeGuard::reportViolation ("pthread_mutex_lock");
+        return pthread_mutex_lock (mutex);
+    }
+
+    int checkedMutexTryLock (pthread_mutex_t* mutex)
+    {
+        RealtimeGuard::reportViolation ("pthread_mutex_trylock");
+        return pthread_mutex_trylock (mutex);
+    }
+
+    int checkedRdLock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::reportViolation ("pthread_rwlock_rdlock");
+        return pthread_rwlock_rdlock (lock);
+    }
+
+    int checkedWrLock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::reportViolation ("pthread_rwlock_wrlock");
+        return pthread_rwlock_wrlock (lock);
+    }
+
+    int checkedTryRdLock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::reportViolation ("pthread_rwlock_tryrdlock");
+        return pthread_rwlock_tryrdlock (lock);
+    }
+
+    int checkedTryWrLock (pthread_rwlock_t* lock)
+    {
+        RealtimeGuard::reportViolation ("pthread_rwlock_trywrlock");
+        return pthread_rwlock_trywrlock (lock);
+    }
+
+    int checkedCondWait (pthread_cond_t* cond, pthread_mutex_t* mutex)
+    {
+        RealtimeGuard::reportViolation ("pthread_cond_wait");
+        return pthread_cond_wait (cond, mutex);
+    }
+
+    int checkedCondTimedWait (pthread_cond_t* cond, pthread_mutex_t* mutex, const timespec* time)
+    {
+        RealtimeGuard::reportViolation ("pthread_cond_timedwait");
+        return pthread_cond_timedwait (cond, mutex, time);
+    }
+
+    struct Interpose { const void* replacement; const void* original; };
+
+    #define PLUGIN_INTERPOSE(replacement, original) \
+        { reinterpret_cast<const void*> (&replacement), reinterpret_cast<const void*> (&original) }
+
+    __attribute__ ((used, section ("__DATA,__interpose")))
+    const Interpose interposers[] {
+        PLUGIN_INTERPOSE (checkedMalloc,        malloc),
+        PLUGIN_INTERPOSE (checkedCalloc,        calloc),
+        PLUGIN_INTERPOSE (checkedRealloc,       realloc),
+        PLUGIN_INTERPOSE (checkedFree,          free),
+        PLUGIN_INTERPOSE (checkedMutexLock,     pthread_mutex_lock),
+        PLUGIN_INTERPOSE (checkedMutexTryLock,  pthread_mutex_trylock),
+        PLUGIN_INTERPOSE (checkedRdLock,        pthread_rwlock_rdlock),
+        PLUGIN_INTERPOSE (checkedWrLock,        pthread_rwlock_wrlock),
+        PLUGIN_INTERPOSE (checkedTryRdLock,     pthread_rwlock_tryrdlock),
+        PLUGIN_INTERPOSE (checkedTryWrLock,     pthread_rwlock_trywrlock),
+        PLUGIN_INTERPOSE (checkedCondWait,      pthread_cond_wait),
+        PLUGIN_INTERPOSE (checkedCondTimedWait, pthread_cond_timedwait),
+    };
+
+    #undef PLUGIN_INTERPOSE
+}
+#endif
+
+#endif // PLUGIN_REALTIME_CHECKS
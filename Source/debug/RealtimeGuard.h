@@ -0,0 +1,79 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#ifndef PLUGIN_REALTIME_CHECKS
+ #define PLUGIN_REALTIME_CHECKS 0
+#endif
+
+//==============================================================================
+/**
+    Debug/test instrumentation that catches real-time violations.
+
+    Build with -DPLUGIN_REALTIME_CHECKS=ON. processBlock() marks the calling
+    thread as the audio thread for its duration; while marked, each of these
+    is recorded together with a raw stack trace:
+
+    - global operator new/delete, including the aligned overloads
+    - malloc, calloc, realloc and free
+    - pthread mutex lock/trylock, rwlock locks and condition variable waits
+
+    Recording itself never allocates. Read the results from a non-audio
+    thread with getReport() or appendReportTo().
+
+    Only trust it in an executable that links this code: the Standalone and
+    PluginTests. On Linux nothing is recorded in a plugin .so that a host
+    dlopens; the host's libstdc++ and libc come first in symbol lookup, so
+    the operator new, malloc and pthread replacements here are never
+    called. On macOS the C allocator and lock hooks are dyld __interpose
+    entries, which skip calls made from this image, so they see the plugin
+    code only when it is linked into another executable. Windows tracks
+    operator new/delete only. The hooks replace the same symbols as
+    AddressSanitizer and ThreadSanitizer, so don't combine the two.
+
+    With the option off everything here compiles away.
+*/
+class RealtimeGuard
+{
+public:
+   #if PLUGIN_REALTIME_CHECKS
+    /** Marks the current thread as inside the audio callback. */
+    class ScopedAudioContext
+    {
+    public:
+        ScopedAudioContext() noexcept;
+        ~ScopedAudioContext() noexcept;
+
+    private:
+        bool previous;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedAudioContext)
+    };
+
+    static bool isAudioContext() noexcept;
+    static void reportViolation (const char* what) noexcept;
+
+    static int getNumViolations() noexcept;
+    static juce::String getReport();
+    static void clear() noexcept;
+
+    /** Appends a timestamped getReport() to file. Returns false if nothing
+        was recorded or the file couldn't be written.
+    */
+    static bool appendReportTo (const juce::File& file);
+   #else
+    class ScopedAudioContext
+    {
+    public:
+        ScopedAudioContext() noexcept {}
+    };
+
+    static bool isAudioContext() noexcept               { return false; }
+    static void reportViolation (const char*) noexcept  {}
+
+    static int getNumViolations() noexcept              { return 0; }
+    static juce::String getReport()                     { return {}; }
+    static void clear() noexcept                        {}
+    static bool appendReportTo (const juce::File&)      { return false; }
+   #endif
+};
@@ -0,0 +1,123 @@
+#include "DryWetMixer.h"
+#include <algorithm>
+
+//==============================================================================
+void DryWetMixer::prepare (double sampleRate, int maximumBlockSize, int numChannels, int latencySamples)
+{
+    maxBlockSize = juce::jmax (1, maximumBlockSize);
+    preparedChannels = juce::jmax (1, numChannels);
+    latency = juce::jmax (0, latencySamples);
+
+    // Room for the delay plus one block written ahead of the read
+    ringSize = juce::nextPowerOfTwo (latency + maxBlockSize);
+    ringMask = ringSize - 1;
+
+    ring.assign (static_cast<size_t> (ringSize * preparedChannels), 0.0f);
+    dryScratch.assign (static_cast<size_t> (maxBlockSize), 0.0f);
+    wetRamp.assign (static_cast<size_t> (maxBlockSize), 1.0f);
+    dryRamp.assign (static_cast<size_t> (maxBlockSize), 0.0f);
+
+    mix.reset (sampleRate, kSmoothingSeconds);
+    reset();
+}
+
+void DryWetMixer::reset() noexcept
+{
+    std::fill (ring.begin(), ring.end(), 0.0f);
+    writePos = 0;
+    active = false;
+    dryPathValid = false;
+    mix.setCurrentAndTargetValue (mix.getTargetValue());
+}
+
+//==============================================================================
+void DryWetMixer::pushDry (const juce::AudioBuffer<float>& buffer, int numChannels, float targetMix) noexcept
+{
+    mix.setTargetValue (juce::jlimit (0.0f, 1.0f, targetMix));
+
+    const int numSamples = buffer.getNumSamples();
+    active = (mix.isSmoothing() || mix.getTargetValue() < 1.0f)
+          && ringSize > 0
+          && numSamples <= ringSize - latency;
+
+    if (! active)
+    {
+        // Whatever is in the ring is about to be out of date
+        dryPathValid = false;
+        mix.setCurrentAndTargetValue (mix.getTargetValue());
+        return;
+    }
+
+    if (! dryPathValid)
+    {
+        std::fill (ring.begin(), ring.end(), 0.0f);
+        dryPathValid = true;
+    }
+
+    numChannels = juce::jmin (numChannels, preparedChannels, buffer.getNumChannels());
+    const int firstRun = juce::jmin (numSamples, ringSize - writePos);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* line = ring.data() + ch * ringSize;
+        const auto* src = buffer.getReadPointer (ch);
+        juce::FloatVectorOperations::copy (line + writePos, src, firstRun);
+        juce::FloatVectorOperations::copy (line, src + firstRun, numSamples - firstRun);
+    }
+
+    writePos = (writePos + numSamples) & ringMask;
+}
+
+void DryWetMixer::mixWet (juce::AudioBuffer<float>& buffer, int numChannels) noexcept
+{
+    if (! active)
+        return;
+
+    numChannels = juce::jmin (numChannels, preparedChannels, buffer.getNumChannels());
+    const int numSamples = buffer.getNumSamples();
+    // writePos already points past this block
+    const int readStart = (writePos - numSamples - latency) & ringMask;
+
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+    {
+        const int count = juce::jmin (maxBlockSize, numSamples - start);
+        const bool ramping = mix.isSmoothing();
+        const float wetGain = mix.getCurrentValue();
+
+        if (ramping)
+        {
+            // One ramp shared by all channels
+            for (int i = 0; i < count; ++i)
+                wetRamp[(size_t) i] = mix.getNextValue();
+
+            juce::FloatVectorOperations::fill (dryRamp.data(), 1.0f, count);
+            juce::FloatVectorOperations::subtract (dryRamp.data(), wetRamp.data(), count);
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch, start);
+            readDelayed (ch, dryScratch.data(), (readStart + start) & ringMask, count);
+
+            if (ramping)
+            {
+                juce::FloatVectorOperations::multiply (data, wetRamp.data(), count);
+                juce::FloatVectorOperations::addWithMultiply (data, dryScratch.data(), dryRamp.data(), count);
+            }
+            else
+            {
+                juce::FloatVectorOperations::multiply (data, wetGain, count);
+                juce::FloatVectorOperations::addWithMultiply (data, dryScratch.data(), 1.0f - wetGain, count);
+            }
+        }
+    }
+}
+
+void DryWetMixer::readDelayed (int channel, float* dest, int readPos, int numSamples) const noexcept
+{
+    const auto* line = ring.data() + channel * ringSize;
+    const int firstRun = juce::jmin (numSamples, ringSize - readPos);
+
+    juce::FloatVectorOperations::copy (dest, line + readPos, firstRun);
+    juce::FloatVectorOperations::copy (dest + firstRun, line, numSamples - firstRun);
+}
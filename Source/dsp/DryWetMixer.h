@@ -0,0 +1,90 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <vector>
+
+//==============================================================================
+/**
+    Latency-compensated parallel dry/wet mix.
+
+    pushDry() stores the untouched input in a power-of-two ring per channel
+    (index arithmetic is a mask, never a modulo); mixWet() reads it back
+    delayed by the processor's reported latency and crossfades:
+
+        out = wet * mix + dry * (1 - mix)
+
+    with a smoothed mix value and FloatVectorOperations for the blend.
+    At 100% wet both calls return immediately, so the default setting costs
+    nothing; the ring is cleared when the dry path comes back so no stale
+    audio leaks in.
+
+    The ring only holds one maximum-size block ahead of the delayed read, so
+    process() runs larger host blocks (hosts don't always keep to what
+    prepareToPlay() promised) in chunks of that size. Calling pushDry() and
+    mixWet() directly with an oversized block leaves it fully wet rather
+    than reading a half-overwritten ring.
+*/
+class DryWetMixer
+{
+public:
+    DryWetMixer() = default;
+
+    void prepare (double sampleRate, int maximumBlockSize, int numChannels, int latencySamples);
+    void reset() noexcept;
+
+    /** pushDry(), processWet (juce::AudioBuffer<float>& chunk) and mixWet()
+        over buffer, in chunks of at most the prepared maximum block size. */
+    template <typename ProcessFn>
+    void process (juce::AudioBuffer<float>& buffer, int numChannels, float targetMix, ProcessFn&& processWet) noexcept
+    {
+        const int numSamples = buffer.getNumSamples();
+
+        if (numSamples <= maxBlockSize)
+        {
+            pushDry (buffer, numChannels, targetMix);
+            processWet (buffer);
+            mixWet (buffer, numChannels);
+            return;
+        }
+
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            const int count = juce::jmin (maxBlockSize, numSamples - start);
+            juce::AudioBuffer<float> chunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, count);
+
+            pushDry (chunk, numChannels, targetMix);
+            processWet (chunk);
+            mixWet (chunk, numChannels);
+        }
+    }
+
+    /** Before processing: captures the dry input if the mix needs it. */
+    void pushDry (const juce::AudioBuffer<float>& buffer, int numChannels, float targetMix) noexcept;
+
+    /** After processing: blends the delayed dry signal into buffer. */
+    void mixWet (juce::AudioBuffer<float>& buffer, int numChannels) noexcept;
+
+    static constexpr double kSmoothingSeconds = 0.05;
+
+private:
+    void readDelayed (int channel, float* dest, int readPos, int numSamples) const noexcept;
+
+    std::vector<float> ring;        // ringSize samples per channel
+    int ringSize = 0;
+    int ringMask = 0;
+    int writePos = 0;
+    int latency = 0;
+    int maxBlockSize = 0;
+    int preparedChannels = 0;
+
+    // Per-block scratch
+    std::vector<float> dryScratch;
+    std::vector<float> wetRamp;
+    std::vector<float> dryRamp;
+
+    juce::SmoothedValue<float> mix { 1.0f };
+    bool active = false;            // set by pushDry() for the current block
+    bool dryPathValid = false;      // false after a fully wet stretch
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DryWetMixer)
+};
@@ -0,0 +1,38 @@
+#include "EnvelopeFollower.h"
+#include <cmath>
+
+//==============================================================================
+namespace
+{
+    float makeCoefficient (double sampleRate, float timeMs) noexcept
+    {
+        const auto samples = sampleRate * static_cast<double> (juce::jmax (0.01f, timeMs)) / 1000.0;
+        return static_cast<float> (std::exp (-1.0 / samples));
+    }
+}
+
+void EnvelopeFollower::prepare (double sampleRate, float attackMs, float releaseMs) noexcept
+{
+    attackCoeff = makeCoefficient (sampleRate, attackMs);
+    releaseCoeff = makeCoefficient (sampleRate, releaseMs);
+    reset();
+}
+
+void EnvelopeFollower::process (float* data, int numSamples) noexcept
+{
+    // Locals, not members: data could alias them, and every store to it
+    // would force a reload inside the loop.
+    const float attack = attackCoeff;
+    const float release = releaseCoeff;
+    float env = envelope;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = data[i];
+        const float coeff = x > env ? attack : release;
+        env = x + coeff * (env - x);
+        data[i] = env;
+    }
+
+    envelope = env;
+}
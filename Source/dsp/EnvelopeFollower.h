@@ -0,0 +1,37 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    One-pole attack/release envelope follower working on whole blocks.
+
+    Feed it an already rectified detector signal; process() overwrites it in
+    place with the envelope. Rectification and whatever curve follows are
+    left to FloatVectorOperations by the caller; this loop is the only
+    scalar part of the chain.
+
+    It stays scalar on purpose: each output depends on the previous one and
+    the coefficient depends on that output (attack or release), so there is
+    no independent work across samples to put in SIMD lanes. What is done
+    instead: the coefficient is a select, not a branch, and the state and
+    coefficients live in registers for the whole block, so the loop is one
+    compare, a select, a subtract and a multiply-add per sample.
+*/
+class EnvelopeFollower
+{
+public:
+    EnvelopeFollower() = default;
+
+    void prepare (double sampleRate, float attackMs, float releaseMs) noexcept;
+    void reset() noexcept  { envelope = 0.0f; }
+
+    void process (float* data, int numSamples) noexcept;
+
+private:
+    float attackCoeff = 0.0f;
+    float releaseCoeff = 0.0f;
+    float envelope = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EnvelopeFollower)
+};
@@ -0,0 +1,21 @@
+#include "FixedBlockAdapter.h"
+
+//==============================================================================
+void FixedBlockAdapter::prepare (int numChannels, int requestedBlockSize)
+{
+    blockSize = (juce::jmax (16, requestedBlockSize) + 15) & ~15;
+
+    for (auto& block : blocks)
+        block.setSize (juce::jmax (1, numChannels), blockSize);
+
+    reset();
+}
+
+void FixedBlockAdapter::reset() noexcept
+{
+    for (auto& block : blocks)
+        block.clear();
+
+    current = 0;
+    fillPos = 0;
+}
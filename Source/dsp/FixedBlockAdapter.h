@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+//==============================================================================
+/**
+    Runs a DSP callback at a fixed internal block size, whatever the host sends.
+
+    Host samples are copied into one preallocated block while the previous,
+    already processed block is copied out, so the callback always sees
+    exactly getBlockSize() samples and the added latency is exactly one
+    block. Block size is rounded up to a multiple of 16 samples so every
+    channel starts SIMD-aligned.
+
+    Useful when hosts split buffers down to a handful of samples around loop
+    points and automation: per-call overhead is paid once per internal block.
+*/
+class FixedBlockAdapter
+{
+public:
+    FixedBlockAdapter() = default;
+
+    void prepare (int numChannels, int requestedBlockSize);
+    void reset() noexcept;
+
+    int getBlockSize() const noexcept       { return blockSize; }
+    int getLatencySamples() const noexcept  { return blockSize; }
+
+    /** processFn (juce::AudioBuffer<float>& block) is called once per full block. */
+    template <typename ProcessFn>
+    void process (juce::AudioBuffer<float>& buffer, ProcessFn&& processFn) noexcept
+    {
+        const int numChannels = juce::jmin (buffer.getNumChannels(), blocks[0].getNumChannels());
+        const int numSamples = buffer.getNumSamples();
+
+        for (int pos = 0; pos < numSamples;)
+        {
+            const int count = juce::jmin (numSamples - pos, blockSize - fillPos);
+            auto& filling = blocks[current];
+            const auto& ready = blocks[1 - current];
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* host = buffer.getWritePointer (ch, pos);
+                juce::FloatVectorOperations::copy (filling.getWritePointer (ch, fillPos), host, count);
+                juce::FloatVectorOperations::copy (host, ready.getReadPointer (ch, fillPos), count);
+            }
+
+            fillPos += count;
+            pos += count;
+
+            if (fillPos == blockSize)
+            {
+                processFn (filling);
+                current = 1 - current;
+                fillPos = 0;
+            }
+        }
+    }
+
+private:
+    juce::AudioBuffer<float> blocks[2];
+    int current = 0;
+    int fillPos = 0;
+    int blockSize = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FixedBlockAdapter)
+};
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "StagePipeline.h"
+
+//==============================================================================
+/**
+    Scalar gain with a linear ramp on changes, so automation and knob moves
+    don't zipper. The ramp is shared by all channels of a block.
+*/
+struct GainRampStage : SampleStage
+{
+    void prepare (double sampleRate) noexcept
+    {
+        rampLength = juce::jmax (1, juce::roundToInt (sampleRate * kRampMs / 1000.0));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        current = blockStart = target;
+        step = 0.0f;
+        remaining = 0;
+    }
+
+    /** Call before each block; takes effect over the next kRampMs. */
+    void setTarget (float newTarget) noexcept
+    {
+        if (newTarget == target)
+            return;
+
+        target = newTarget;
+        remaining = rampLength;
+        step = (target - current) / static_cast<float> (rampLength);
+    }
+
+    /** Settled at 0 dB: the stage would not change anything. */
+    bool isUnity() const noexcept   { return remaining == 0 && target == 1.0f; }
+
+    void beginBlock (int) noexcept  { blockStart = current; }
+
+    float processSample (float x, int sampleIndex) const noexcept
+    {
+        return x * (blockStart + step * static_cast<float> (juce::jmin (sampleIndex + 1, remaining)));
+    }
+
+    void endBlock (int numSamples) noexcept
+    {
+        remaining -= juce::jmin (numSamples, remaining);
+        current = remaining > 0 ? blockStart + step * static_cast<float> (numSamples) : target;
+        if (remaining == 0)
+            step = 0.0f;
+    }
+
+    static constexpr double kRampMs = 20.0;
+
+private:
+    float target = 1.0f;
+    float current = 1.0f;
+    float blockStart = 1.0f;
+    float step = 0.0f;
+    int remaining = 0;
+    int rampLength = 1;
+};
+
+//==============================================================================
+/** Multiplies by a per-sample gain curve computed by a block-level stage. */
+struct GainCurveStage : SampleStage
+{
+    /** Must hold at least the next block's numSamples values. */
+    void setCurve (const float* newCurve) noexcept  { curve = newCurve; }
+
+    float processSample (float x, int sampleIndex) const noexcept
+    {
+        return x * curve[sampleIndex];
+    }
+
+private:
+    const float* curve = nullptr;
+};
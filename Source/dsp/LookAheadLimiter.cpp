@@ -0,0 +1,233 @@
+#include "LookAheadLimiter.h"
+#include <algorithm>
+#include <cmath>
+
+//==============================================================================
+void LookAheadLimiter::prepare (double sampleRate, int maximumBlockSize, int numChannels)
+{
+    lookahead = juce::jmax (1, juce::roundToInt (sampleRate * kLookaheadMs / 1000.0));
+    latency = lookahead + kDetectorDelay;
+    window = lookahead + 1;
+    maxBlockSize = juce::jmax (1, maximumBlockSize);
+    preparedChannels = juce::jmax (1, numChannels);
+
+    ceiling = juce::Decibels::decibelsToGain (kCeilingDb);
+    releaseCoeff = static_cast<float> (std::exp (-1.0 / (sampleRate * kReleaseMs / 1000.0)));
+
+    delayLines.assign (static_cast<size_t> (latency * preparedChannels), 0.0f);
+    peakScratch.assign (static_cast<size_t> (maxBlockSize), 0.0f);
+    gainScratch.assign (static_cast<size_t> (maxBlockSize), 1.0f);
+    interpHistory.assign (static_cast<size_t> ((kTaps - 1) * preparedChannels), 0.0f);
+    interpInput.assign (static_cast<size_t> (maxBlockSize + kTaps - 1), 0.0f);
+
+    // Hann-windowed sinc at 1/4, 2/4 and 3/4 of the way between taps
+    // kDetectorDelay - 1 and kDetectorDelay, normalised to unity DC gain
+    for (size_t p = 0; p < phaseCoeffs.size(); ++p)
+    {
+        const double frac = static_cast<double> (p + 1) / kOversampling;
+        double sum = 0.0;
+
+        for (int k = 0; k < kTaps; ++k)
+        {
+            const double t = (kDetectorDelay - 1) + frac - k;
+            const double sinc = std::sin (juce::MathConstants<double>::pi * t) / (juce::MathConstants<double>::pi * t);
+            const double hann = 0.5 * (1.0 + std::cos (juce::MathConstants<double>::pi * t / kDetectorDelay));
+            phaseCoeffs[p][(size_t) k] = static_cast<float> (sinc * hann);
+            sum += sinc * hann;
+        }
+
+        for (auto& c : phaseCoeffs[p])
+            c = static_cast<float> (c / sum);
+    }
+    segment.assign (static_cast<size_t> (window), 0.0f);
+    suffixMax.assign (static_cast<size_t> (window + 1), 0.0f);
+    rampRing.assign (static_cast<size_t> (window), 1.0f);
+
+    reset();
+}
+
+void LookAheadLimiter::reset() noexcept
+{
+    std::fill (delayLines.begin(), delayLines.end(), 0.0f);
+    delayPos = 0;
+    bypassFadePos = window;
+
+    std::fill (interpHistory.begin(), interpHistory.end(), 0.0f);
+
+    std::fill (segment.begin(), segment.end(), 0.0f);
+    std::fill (suffixMax.begin(), suffixMax.end(), 0.0f);
+    segmentPos = 0;
+    runningMax = 0.0f;
+
+    envelope = 1.0f;
+    std::fill (rampRing.begin(), rampRing.end(), 1.0f);
+    rampPos = 0;
+    rampSum = static_cast<double> (window);
+}
+
+//==============================================================================
+void LookAheadLimiter::process (juce::AudioBuffer<float>& buffer, int numChannels, bool enabled) noexcept
+{
+    numChannels = juce::jmin (numChannels, preparedChannels, buffer.getNumChannels());
+    if (numChannels <= 0)
+        return;
+
+    // Hosts may exceed the block size promised in prepareToPlay.
+    const int numSamples = buffer.getNumSamples();
+    for (int start = 0; start < numSamples; start += maxBlockSize)
+        processChunk (buffer, numChannels, start, juce::jmin (maxBlockSize, numSamples - start), enabled);
+}
+
+void LookAheadLimiter::processChunk (juce::AudioBuffer<float>& buffer, int numChannels,
+                                     int startSample, int numSamples, bool enabled) noexcept
+{
+    // Always: the gain must already cover the delay line when switched on
+    computeGain (buffer, numChannels, startSample, numSamples);
+
+    bool applyGain = enabled;
+
+    if (enabled)
+    {
+        bypassFadePos = 0;
+    }
+    else if (bypassFadePos < window)
+    {
+        fadeOutGain (numSamples);
+        applyGain = true;
+    }
+
+    // Delay each channel by `latency`: swapping with the ring returns the
+    // delayed samples in place and stores the new ones in one pass.
+    int endPos = delayPos;
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* data = buffer.getWritePointer (ch, startSample);
+        auto* line = delayLines.data() + ch * latency;
+
+        int pos = delayPos;
+        for (int done = 0; done < numSamples;)
+        {
+            const int run = juce::jmin (numSamples - done, latency - pos);
+            std::swap_ranges (data + done, data + done + run, line + pos);
+            done += run;
+            pos += run;
+            if (pos == latency)
+                pos = 0;
+        }
+        endPos = pos;
+
+        if (applyGain)
+            juce::FloatVectorOperations::multiply (data, gainScratch.data(), numSamples);
+    }
+
+    delayPos = endPos;
+}
+
+void LookAheadLimiter::fadeOutGain (int numSamples) noexcept
+{
+    // gain + (1 - gain) * fade, fade rising linearly to 1 over `window`
+    auto* gain = gainScratch.data();
+    const auto step = 1.0f / static_cast<float> (window);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto fade = juce::jmin (1.0f, static_cast<float> (bypassFadePos + i + 1) * step);
+        gain[i] += (1.0f - gain[i]) * fade;
+    }
+
+    bypassFadePos = juce::jmin (window, bypassFadePos + numSamples);
+}
+
+void LookAheadLimiter::computeGain (juce::AudioBuffer<float>& buffer, int numChannels,
+                                    int startSample, int numSamples) noexcept
+{
+    auto* peak = peakScratch.data();
+    auto* gain = gainScratch.data();
+
+    // 1. Linked true peak: max over channels of the 4x oversampled |x|,
+    //    kDetectorDelay samples behind the input
+    for (int ch = 0; ch < numChannels; ++ch)
+        detectTruePeak (buffer.getReadPointer (ch, startSample), ch, numSamples);
+
+    // 2. Max over the last `window` samples. The timeline is cut into
+    //    window-sized segments; the answer is the max of the previous
+    //    segment's suffix and the current segment's prefix.
+    auto* seg = segment.data();
+    auto* suffix = suffixMax.data();
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float x = peak[i];
+        runningMax = juce::jmax (runningMax, x);
+        seg[segmentPos] = x;
+        peak[i] = juce::jmax (suffix[segmentPos + 1], runningMax);
+
+        if (++segmentPos == window)
+        {
+            float m = 0.0f;
+            for (int k = window; --k >= 0;)
+                suffix[k] = m = juce::jmax (m, seg[k]);
+
+            segmentPos = 0;
+            runningMax = 0.0f;
+        }
+    }
+
+    // 3. Gain needed to keep the held peak under the ceiling
+    juce::FloatVectorOperations::max (peak, peak, ceiling, numSamples);
+    for (int i = 0; i < numSamples; ++i)
+        gain[i] = ceiling / peak[i];
+
+    // 4. Instant attack / exponential release, then a `window`-long moving
+    //    average so the gain ramps down over the look-ahead and reaches its
+    //    target exactly when the peak leaves the delay line (the delay line
+    //    is kDetectorDelay longer than the ramp to cover the interpolator).
+    auto* ramp = rampRing.data();
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float target = gain[i];
+        envelope = target < envelope ? target : target + releaseCoeff * (envelope - target);
+
+        rampSum += static_cast<double> (envelope - ramp[rampPos]);
+        ramp[rampPos] = envelope;
+        if (++rampPos == window)
+            rampPos = 0;
+
+        gain[i] = static_cast<float> (rampSum) / static_cast<float> (window);
+    }
+}
+
+void LookAheadLimiter::detectTruePeak (const float* input, int channel, int numSamples) noexcept
+{
+    constexpr int historySize = kTaps - 1;
+    auto* history = interpHistory.data() + channel * historySize;
+    auto* x = interpInput.data();
+    auto* peak = peakScratch.data();
+    auto* interp = gainScratch.data();
+
+    juce::FloatVectorOperations::copy (x, history, historySize);
+    juce::FloatVectorOperations::copy (x + historySize, input, numSamples);
+    juce::FloatVectorOperations::copy (history, x + numSamples, historySize);
+
+    // The sample itself, delayed to line up with the interpolated phases
+    const auto* centre = x + kDetectorDelay - 1;
+    if (channel == 0)
+    {
+        juce::FloatVectorOperations::abs (peak, centre, numSamples);
+    }
+    else
+    {
+        juce::FloatVectorOperations::abs (interp, centre, numSamples);
+        juce::FloatVectorOperations::max (peak, peak, interp, numSamples);
+    }
+
+    // One FIR per phase, as a sum of shifted, scaled copies of the input
+    for (const auto& coeffs : phaseCoeffs)
+    {
+        juce::FloatVectorOperations::multiply (interp, x, coeffs[0], numSamples);
+        for (int k = 1; k < kTaps; ++k)
+            juce::FloatVectorOperations::addWithMultiply (interp, x + k, coeffs[(size_t) k], numSamples);
+
+        juce::FloatVectorOperations::abs (interp, interp, numSamples);
+        juce::FloatVectorOperations::max (peak, peak, interp, numSamples);
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <vector>
+
+//==============================================================================
+/**
+    Channel-linked look-ahead true-peak limiter for the output stage.
+
+    - Peaks are detected on a 4x oversampled signal: three points between
+      every pair of samples come from an 8-tap windowed-sinc interpolator,
+      so inter-sample overs are caught as well as sample peaks.
+    - Detection, interpolation and gain application use FloatVectorOperations.
+    - The look-ahead window max is a streaming van Herk / Gil-Werman filter:
+      two comparisons per sample plus one backward scan per window, so the
+      cost per sample is constant whatever the host block size is.
+    - All buffers are sized in prepare(); process() never allocates.
+
+    The signal is always delayed by getLatencySamples(), even when bypassed,
+    so the reported latency never changes while playing. The detector keeps
+    running while bypassed as well: switching on limits from the first
+    sample, including whatever is already in the delay line, and switching
+    off fades the gain reduction out over the look-ahead window instead of
+    jumping to unity. Bypassed therefore costs as much as limiting.
+
+    Guarantee: output sample peaks never exceed the ceiling. Inter-sample
+    peaks are only as good as 4x detection, which can under-read a
+    near-Nyquist peak by up to ~0.7 dB (the same bound ITU-R BS.1770 gives
+    for 4x meters); the -0.3 dB ceiling absorbs most of that.
+*/
+class LookAheadLimiter
+{
+public:
+    LookAheadLimiter() = default;
+
+    void prepare (double sampleRate, int maximumBlockSize, int numChannels);
+    void reset() noexcept;
+
+    void process (juce::AudioBuffer<float>& buffer, int numChannels, bool enabled) noexcept;
+
+    int getLatencySamples() const noexcept { return latency; }
+
+private:
+    void processChunk (juce::AudioBuffer<float>& buffer, int numChannels,
+                       int startSample, int numSamples, bool enabled) noexcept;
+    void computeGain (juce::AudioBuffer<float>& buffer, int numChannels,
+                      int startSample, int numSamples) noexcept;
+    void fadeOutGain (int numSamples) noexcept;
+    void detectTruePeak (const float* input, int channel, int numSamples) noexcept;
+
+    // 4x oversampled detection: 3 interpolated phases, kTaps-tap FIR each.
+    // The detector sees sample n once n + kTaps/2 has arrived.
+    static constexpr int kOversampling = 4;
+    static constexpr int kTaps = 8;
+    static constexpr int kDetectorDelay = kTaps / 2;
+
+    static constexpr float kLookaheadMs = 1.5f;
+    static constexpr float kReleaseMs   = 60.0f;
+    static constexpr float kCeilingDb   = -0.3f;
+
+    int lookahead = 0;          // gain ramp lead in samples
+    int latency = 0;            // lookahead + kDetectorDelay: delay line length
+    int window = 1;             // lookahead + 1: peak hold and gain ramp length
+    int maxBlockSize = 0;
+    int preparedChannels = 0;
+
+    float ceiling = 1.0f;
+    float releaseCoeff = 0.0f;
+
+    // Delay lines, one run of `latency` samples per channel
+    std::vector<float> delayLines;
+    int delayPos = 0;
+
+    // Per-block scratch
+    std::vector<float> peakScratch;
+    std::vector<float> gainScratch;
+
+    // Interpolator: coefficients per phase, last kTaps - 1 inputs per channel,
+    // and [history | block] scratch so the FIR never wraps
+    std::array<std::array<float, kTaps>, kOversampling - 1> phaseCoeffs {};
+    std::vector<float> interpHistory;
+    std::vector<float> interpInput;
+
+    // Sliding window max state
+    std::vector<float> segment;
+    std::vector<float> suffixMax;     // window + 1 entries, last is 0
+    int segmentPos = 0;
+    float runningMax = 0.0f;
+
+    // Release follower + box-filter gain ramp
+    float envelope = 1.0f;
+    std::vector<float> rampRing;
+    int rampPos = 0;
+    double rampSum = 0.0;
+
+    // Samples since the limiter was switched off; the gain reaches unity
+    // at `window`
+    int bypassFadePos = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LookAheadLimiter)
+};
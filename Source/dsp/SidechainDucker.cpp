@@ -0,0 +1,77 @@
+#include "SidechainDucker.h"
+
+//==============================================================================
+void SidechainDucker::prepare (double sampleRate, int maximumBlockSize)
+{
+    maxBlockSize = juce::jmax (1, maximumBlockSize);
+
+    curveScratch.assign (static_cast<size_t> (maxBlockSize), 0.0f);
+    channelScratch.assign (static_cast<size_t> (maxBlockSize), 0.0f);
+
+    follower.prepare (sampleRate, kAttackMs, kReleaseMs);
+    reset();
+}
+
+void SidechainDucker::reset() noexcept
+{
+    follower.reset();
+}
+
+//==============================================================================
+const float* SidechainDucker::computeGainCurve (const juce::AudioBuffer<float>& sidechain, int startSample,
+                                                int numSamples, float thresholdDb, float depthDb) noexcept
+{
+    jassert (numSamples <= maxBlockSize);
+    numSamples = juce::jmin (numSamples, maxBlockSize);
+
+    auto* curve = curveScratch.data();
+
+    if (! isActive (sidechain, depthDb))
+    {
+        // Callers leave the curve stage out instead
+        jassertfalse;
+        follower.reset();
+        juce::FloatVectorOperations::fill (curve, 1.0f, numSamples);
+        return curve;
+    }
+
+    const auto inverseThreshold = 1.0f / juce::Decibels::decibelsToGain (thresholdDb);
+    const auto depthGain = juce::Decibels::decibelsToGain (-depthDb);
+
+    auto* scratch = channelScratch.data();
+
+    // 1. Linked detector: max over sidechain channels of |x|
+    juce::FloatVectorOperations::abs (curve, sidechain.getReadPointer (0, startSample), numSamples);
+    for (int ch = 1; ch < sidechain.getNumChannels(); ++ch)
+    {
+        juce::FloatVectorOperations::abs (scratch, sidechain.getReadPointer (ch, startSample), numSamples);
+        juce::FloatVectorOperations::max (curve, curve, scratch, numSamples);
+    }
+
+    // 2. Attack / release
+    follower.process (curve, numSamples);
+
+    // 3. Reduction amount, 0 at the threshold, 1 at 6 dB above it
+    juce::FloatVectorOperations::multiply (curve, inverseThreshold, numSamples);
+    juce::FloatVectorOperations::add (curve, -1.0f, numSamples);
+    juce::FloatVectorOperations::clip (curve, curve, 0.0f, 1.0f, numSamples);
+
+    const auto maxAmount = juce::FloatVectorOperations::findMaximum (curve, numSamples);
+    publishReduction (-juce::Decibels::gainToDecibels (1.0f - maxAmount * (1.0f - depthGain)));
+
+    // 4. Gain curve
+    juce::FloatVectorOperations::multiply (curve, -(1.0f - depthGain), numSamples);
+    juce::FloatVectorOperations::add (curve, 1.0f, numSamples);
+
+    return curve;
+}
+
+void SidechainDucker::publishReduction (float reductionDb) noexcept
+{
+    // Peak-hold: keep the largest value until the UI consumes it
+    auto current = peakReductionDb.load (std::memory_order_relaxed);
+    while (reductionDb > current
+           && ! peakReductionDb.compare_exchange_weak (current, reductionDb, std::memory_order_relaxed))
+    {
+    }
+}
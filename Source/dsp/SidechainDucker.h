@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "EnvelopeFollower.h"
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+    Ducks the main signal under a sidechain (voice-over over music).
+
+    A block-level stage: the sidechain is rectified and channel-linked,
+    smoothed by an EnvelopeFollower, and turned into a per-sample gain curve
+    that a GainCurveStage applies inside the fused gain loop:
+
+        amount = clamp (envelope / threshold - 1, 0, 1)
+        gain   = 1 - amount * (1 - depth)
+
+    so reduction starts at the threshold and reaches the full depth 6 dB
+    above it. Everything but the envelope recursion is FloatVectorOperations;
+    all buffers are sized in prepare() and nothing here allocates.
+
+    The largest reduction is published through a lock-free peak-hold that
+    the UI consumes at its own rate.
+*/
+class SidechainDucker
+{
+public:
+    SidechainDucker() = default;
+
+    void prepare (double sampleRate, int maximumBlockSize);
+    void reset() noexcept;
+
+    /** False when depthDb <= 0 or the sidechain has no channels: callers
+        reset() and leave the curve stage out rather than apply all ones. */
+    static bool isActive (const juce::AudioBuffer<float>& sidechain, float depthDb) noexcept
+    {
+        return depthDb > 0.0f && sidechain.getNumChannels() > 0;
+    }
+
+    /** Gain curve for numSamples (at most getMaximumBlockSize()) samples of
+        sidechain starting at startSample; only while isActive(). The pointer
+        stays valid until the next call. */
+    const float* computeGainCurve (const juce::AudioBuffer<float>& sidechain, int startSample, int numSamples,
+                                   float thresholdDb, float depthDb) noexcept;
+
+    int getMaximumBlockSize() const noexcept  { return maxBlockSize; }
+
+    /** Any thread: largest gain reduction in dB since the previous call. */
+    float consumePeakReductionDb() noexcept  { return peakReductionDb.exchange (0.0f); }
+
+    static constexpr float kAttackMs  = 10.0f;
+    static constexpr float kReleaseMs = 300.0f;
+
+private:
+    void publishReduction (float reductionDb) noexcept;
+
+    EnvelopeFollower follower;
+    int maxBlockSize = 0;
+
+    // Per-block scratch: detector / gain curve, and one rectified channel
+    std::vector<float> curveScratch;
+    std::vector<float> channelScratch;
+
+    std::atomic<float> peakReductionDb { 0.0f };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SidechainDucker)
+};
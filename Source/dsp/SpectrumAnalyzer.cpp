@@ -0,0 +1,152 @@
+#include "SpectrumAnalyzer.h"
+#include <cmath>
+
+//==============================================================================
+SpectrumAnalyzer::SpectrumAnalyzer()
+    : fifoBuffer (static_cast<size_t> (fifo.getTotalSize()), 0.0f),
+      history (static_cast<size_t> (kFftSize), 0.0f),
+      fftData (static_cast<size_t> (2 * kFftSize), 0.0f)
+{
+}
+
+void SpectrumAnalyzer::pushSamples (const juce::AudioBuffer<float>& buffer, int numChannels) noexcept
+{
+    if (! active.load (std::memory_order_relaxed) || numChannels <= 0)
+        return;
+
+    // If the consumer falls behind, the newest samples are dropped.
+    const auto scope = fifo.write (buffer.getNumSamples());
+    const float scale = 1.0f / static_cast<float> (numChannels);
+
+    auto mixInto = [&] (int fifoStart, int count, int bufferStart)
+    {
+        if (count <= 0)
+            return;
+
+        auto* dest = fifoBuffer.data() + fifoStart;
+        juce::FloatVectorOperations::copyWithMultiply (dest, buffer.getReadPointer (0, bufferStart), scale, count);
+
+        for (int ch = 1; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::addWithMultiply (dest, buffer.getReadPointer (ch, bufferStart), scale, count);
+    };
+
+    mixInto (scope.startIndex1, scope.blockSize1, 0);
+    mixInto (scope.startIndex2, scope.blockSize2, scope.blockSize1);
+}
+
+//==============================================================================
+void SpectrumAnalyzer::setActive (bool shouldBeActive) noexcept
+{
+    // Drop whatever was left from the last time a view was open. Only the
+    // read side moves: resetting the FIFO would race an audio callback that
+    // saw the analyzer active a moment ago and is still writing.
+    if (shouldBeActive && ! active.load())
+        discardHistory();
+
+    active.store (shouldBeActive);
+}
+
+bool SpectrumAnalyzer::process()
+{
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    const auto rate = sampleRate.load();
+    if (rate != tableSampleRate)
+        rebuildPointTable (rate);
+
+    bool updated = false;
+    const auto scope = fifo.read (fifo.getNumReady());
+
+    scope.forEach ([&] (int index)
+    {
+        history[(size_t) historyPos] = fifoBuffer[(size_t) index];
+        historyPos = (historyPos + 1) & (kFftSize - 1);
+
+        if (++samplesSinceFft == kHopSize)
+        {
+            samplesSinceFft = 0;
+            runFft();
+            updated = true;
+        }
+    });
+
+    processTicks += juce::Time::getHighResolutionTicks() - startTicks;
+    ++processCalls;
+
+    return updated;
+}
+
+void SpectrumAnalyzer::discardHistory()
+{
+    // Reader side only: consume what's there without looking at it
+    fifo.read (fifo.getNumReady());
+
+    std::fill (history.begin(), history.end(), 0.0f);
+    historyPos = 0;
+    samplesSinceFft = 0;
+    std::fill (levels.begin(), levels.end(), 0.0f);
+}
+
+void SpectrumAnalyzer::runFft()
+{
+    // Unroll the history so the oldest sample comes first.
+    const auto split = static_cast<size_t> (historyPos);
+    std::copy (history.begin() + (std::ptrdiff_t) split, history.end(), fftData.begin());
+    std::copy (history.begin(), history.begin() + (std::ptrdiff_t) split, fftData.begin() + (std::ptrdiff_t) (kFftSize - split));
+
+    window.multiplyWithWindowingTable (fftData.data(), static_cast<size_t> (kFftSize));
+    fft.performFrequencyOnlyForwardTransform (fftData.data(), true);
+
+    // Hann window halves the amplitude; normalise a full-scale sine to 0 dB.
+    const float norm = 4.0f / static_cast<float> (kFftSize);
+    constexpr float decay = 0.85f;
+
+    for (int p = 0; p < kNumPoints; ++p)
+    {
+        float peak = 0.0f;
+        for (int bin = pointBins[(size_t) p]; bin < pointBins[(size_t) p + 1]; ++bin)
+            peak = juce::jmax (peak, fftData[(size_t) bin]);
+
+        const auto db = juce::Decibels::gainToDecibels (peak * norm, kMinDb);
+        const auto level = juce::jmap (db, kMinDb, 0.0f, 0.0f, 1.0f);
+
+        auto& current = levels[(size_t) p];
+        current = juce::jmax (level, current * decay);
+    }
+}
+
+void SpectrumAnalyzer::rebuildPointTable (double rate)
+{
+    tableSampleRate = rate;
+
+    // Points spaced logarithmically from 20 Hz to Nyquist; every point
+    // covers at least one bin so the low end isn't full of gaps.
+    const int numBins = kFftSize / 2;
+    int previous = 1;
+
+    for (int p = 0; p <= kNumPoints; ++p)
+    {
+        const auto freq = getFrequencyForPoint (p);
+        auto bin = juce::jlimit (1, numBins, static_cast<int> (freq * kFftSize / rate));
+        if (p > 0)
+            bin = juce::jmax (bin, previous + 1);
+
+        pointBins[(size_t) p] = juce::jmin (bin, numBins);
+        previous = pointBins[(size_t) p];
+    }
+}
+
+float SpectrumAnalyzer::getFrequencyForPoint (int index) const noexcept
+{
+    const auto nyquist = static_cast<float> (sampleRate.load() * 0.5);
+    const auto t = static_cast<float> (index) / static_cast<float> (kNumPoints);
+    return 20.0f * std::pow (nyquist / 20.0f, t);
+}
+
+double SpectrumAnalyzer::getAverageProcessMs() const noexcept
+{
+    if (processCalls == 0)
+        return 0.0;
+
+    return juce::Time::highResolutionTicksToSeconds (processTicks) * 1000.0 / static_cast<double> (processCalls);
+}
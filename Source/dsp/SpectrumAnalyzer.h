@@ -0,0 +1,81 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+    Output spectrum analyzer split across threads.
+
+    Audio thread: pushSamples() mixes the block to mono straight into a
+    lock-free FIFO. When no view is attached it returns after one atomic
+    load, so a closed editor costs nothing.
+
+    Consumer (UI timer): process() drains the FIFO, runs a Hann-windowed
+    FFT every kHopSize samples and reduces the bins to kNumPoints
+    log-spaced levels (0..1 over kMinDb..0 dB) with peak-hold decay.
+*/
+class SpectrumAnalyzer
+{
+public:
+    static constexpr int kFftOrder = 11;
+    static constexpr int kFftSize = 1 << kFftOrder;
+    static constexpr int kHopSize = kFftSize / 4;
+    static constexpr int kNumPoints = 128;
+    static constexpr float kMinDb = -90.0f;
+
+    SpectrumAnalyzer();
+
+    //==============================================================================
+    // Audio thread
+    void prepare (double newSampleRate) noexcept { sampleRate.store (newSampleRate); }
+    void pushSamples (const juce::AudioBuffer<float>& buffer, int numChannels) noexcept;
+
+    //==============================================================================
+    // Consumer thread
+    void setActive (bool shouldBeActive) noexcept;
+    bool isActive() const noexcept { return active.load (std::memory_order_relaxed); }
+
+    /** Returns true if getLevels() changed. */
+    bool process();
+
+    const std::array<float, kNumPoints>& getLevels() const noexcept { return levels; }
+
+    /** Frequency (Hz) of point i, for drawing a grid. */
+    float getFrequencyForPoint (int index) const noexcept;
+
+    /** Mean time spent in process() per call, in milliseconds. */
+    double getAverageProcessMs() const noexcept;
+
+private:
+    void runFft();
+    void rebuildPointTable (double rate);
+    void discardHistory();
+
+    std::atomic<bool> active { false };
+    std::atomic<double> sampleRate { 44100.0 };
+
+    // Audio -> consumer FIFO (about 0.7 s at 48 kHz)
+    juce::AbstractFifo fifo { 1 << 15 };
+    std::vector<float> fifoBuffer;
+
+    // Consumer state
+    juce::dsp::FFT fft { kFftOrder };
+    juce::dsp::WindowingFunction<float> window { static_cast<size_t> (kFftSize),
+                                                 juce::dsp::WindowingFunction<float>::hann, false };
+    std::vector<float> history;           // last kFftSize samples, circular
+    int historyPos = 0;
+    int samplesSinceFft = 0;
+    std::vector<float> fftData;           // 2 * kFftSize, as juce::dsp::FFT wants
+
+    double tableSampleRate = 0.0;
+    std::array<int, kNumPoints + 1> pointBins {};
+    std::array<float, kNumPoints> levels {};
+
+    juce::int64 processTicks = 0;
+    juce::int64 processCalls = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumAnalyzer)
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <tuple>
+
+//==============================================================================
+/**
+    Base for per-sample stages that can be fused into one loop.
+
+    A stage provides
+
+        float processSample (float x, int sampleIndex) noexcept;
+
+    and may override any of the hooks below (they are resolved statically,
+    nothing is virtual). sampleIndex is relative to the current block, so a
+    stage can index per-block data shared by all channels.
+*/
+struct SampleStage
+{
+    void beginBlock (int /*numSamples*/) noexcept {}
+    void beginChannel (int /*channel*/) noexcept {}
+    void endChannel (int /*channel*/) noexcept {}
+    void endBlock (int /*numSamples*/) noexcept {}
+};
+
+//==============================================================================
+/**
+    Compile-time fusion of per-sample stages.
+
+        FusedStages<GainRampStage, GainCurveStage, ...> fused;
+        fused.process (buffer, numChannels, start, numSamples);
+
+    runs every stage, in declaration order, inside a single loop per channel:
+    each sample is loaded once, passed through all stages in registers and
+    stored once, instead of one full buffer pass per stage. The stage chain
+    is a template parameter pack, so calls are inlined and there is no
+    per-sample dispatch.
+
+    Anything that needs the whole block (look-ahead, FFT, detectors feeding
+    curves) stays outside as a block-level stage: the caller runs it
+    between two fused groups, which is the barrier.
+*/
+template <typename... Stages>
+class FusedStages
+{
+public:
+    FusedStages() = default;
+
+    template <size_t Index>
+    auto& get() noexcept                { return std::get<Index> (stages); }
+
+    template <typename Stage>
+    Stage& get() noexcept               { return std::get<Stage> (stages); }
+
+    void process (juce::AudioBuffer<float>& buffer, int numChannels, int startSample, int numSamples) noexcept
+    {
+        std::apply ([&] (auto&... chain)
+        {
+            run (buffer, juce::jmin (numChannels, buffer.getNumChannels()), startSample, numSamples, chain...);
+        }, stages);
+    }
+
+    /** Runs only the listed stages, in the order given, for blocks where the
+        others would change nothing (e.g. a curve stage with no curve). */
+    template <typename... Subset>
+    void processOnly (juce::AudioBuffer<float>& buffer, int numChannels, int startSample, int numSamples) noexcept
+    {
+        run (buffer, juce::jmin (numChannels, buffer.getNumChannels()), startSample, numSamples,
+             std::get<Subset> (stages)...);
+    }
+
+private:
+    template <typename... Chain>
+    static void run (juce::AudioBuffer<float>& buffer, int numChannels, int startSample, int numSamples,
+                     Chain&... chain) noexcept
+    {
+        (chain.beginBlock (numSamples), ...);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            (chain.beginChannel (ch), ...);
+
+            auto* data = buffer.getWritePointer (ch, startSample);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float x = data[i];
+                ((x = chain.processSample (x, i)), ...);
+                data[i] = x;
+            }
+
+            (chain.endChannel (ch), ...);
+        }
+
+        (chain.endBlock (numSamples), ...);
+    }
+
+    std::tuple<Stages...> stages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FusedStages)
+};
@@ -0,0 +1,285 @@
+#include "ControlSurface.h"
+
+//==============================================================================
+ControlSurface::ControlSurface (Parameters& parametersToControl, ui_core::HardwareOutputAdapter* output)
+    : parameters (parametersToControl),
+      hardwareOutput (output != nullptr ? *output : defaultOutput),
+      focusAdapters (static_cast<size_t> (kNumControls))
+{
+    controlIndexByParameter.fill (-1);
+    lastDisplayedValue.fill (std::numeric_limits<float>::quiet_NaN());
+
+    // Focus adapters and bindings (mapped: native spec range <-> normalized 0..1)
+    for (int i = 0; i < kNumControls; ++i)
+    {
+        const auto& control = kControls[i];
+        const auto& spec = Parameters::getSpec (control.parameter);
+        const auto start = spec.minValue;
+        const auto length = spec.maxValue - spec.minValue;
+
+        controlIndexById[control.id] = i;
+        controlIndexByParameter[(size_t) control.parameter] = i;
+
+        auto& adapter = focusAdapters[(size_t) i];
+        adapter.owner = this;
+        adapter.controlIndex = i;
+        focusManager.registerWidget (control.id, &adapter);
+
+        auto binding = ui_core::makeMappedBinding (
+            control.id,
+            [this, index = control.parameter]() { return parameters.getValue (index); },
+            [this, i] (float native) { setControlValue (i, native); },
+            [start, length] (float normalized) { return start + normalized * length; },
+            [start, length] (float native) { return (native - start) / length; });
+        binding.onGestureBegin = [this, index = control.parameter] { parameters.beginChangeGesture (index); };
+        binding.onGestureEnd   = [this, index = control.parameter] { parameters.endChangeGesture (index); };
+        bindingRegistry.add (std::move (binding));
+
+        // Name line is static; the value line follows the parameter
+        displays.addDisplay (control.id);
+        displays.setText (control.id, ui_core::kDisplayNameLine, spec.name);
+    }
+
+   #if PLUGIN_OSC_PORT > 0
+    // OSC touch surfaces: absolute 0..1 on /<name>, relative deltas on /<name>/delta
+    oscInput = std::make_unique<OscInputBackend> (hardwareAdapter);
+    for (const auto& control : kControls)
+    {
+        oscInput->addAddress (control.oscAddress, control.id);
+        oscInput->addAddress (juce::String (control.oscAddress) + "/delta", control.id, true);
+    }
+
+    // Further instances take the next free port; without one, OSC is off
+    // and the plugin carries on
+    if (oscInput->start (PLUGIN_OSC_PORT, "127.0.0.1", kOscPortsToTry))
+        juce::Logger::writeToLog ("OSC input: listening on port " + juce::String (oscInput->getPort()));
+    else
+        juce::Logger::writeToLog ("OSC input: ports " + juce::String (PLUGIN_OSC_PORT) + "-"
+                                  + juce::String (PLUGIN_OSC_PORT + kOscPortsToTry - 1) + " unavailable, OSC off");
+   #endif
+
+    // Initial focus, sent to the hardware once for the plugin's lifetime
+    const auto persisted = findControlIndex (static_cast<ui_core::ControlId> (parameters.getFocusedControlId()));
+    const int initialIndex = persisted >= 0 ? persisted : 0;
+
+    for (int i = 0; i < kNumControls; ++i)
+        hardwareOutput.setFocus (kControls[i].id, i == initialIndex);
+
+    focusManager.setFocusedControl (kControls[initialIndex].id);
+
+    updateDisplayValues();
+    displays.flush (juce::Time::getMillisecondCounter());
+    startTimerHz (kDisplayRefreshHz);
+}
+
+ControlSurface::~ControlSurface()
+{
+    stopTimer();
+
+    // Stop the receive thread and replay before the adapter they feed goes away
+    oscInput.reset();
+    eventPlayer.reset();
+    hardwareAdapter.setRecorder (nullptr);
+    hardwareAdapter.endAllGestures();
+
+    for (int i = 0; i < kNumControls; ++i)
+        focusManager.unregisterWidget (kControls[i].id, &focusAdapters[(size_t) i]);
+}
+
+//==============================================================================
+void ControlSurface::focusControl (int index)
+{
+    if (index < 0 || index >= kNumControls)
+        return;
+
+    const auto newFocusId = kControls[index].id;
+    const auto prev = focusManager.getFocusedControl();
+
+    focusManager.setFocusedControl (newFocusId);
+    parameters.setFocusedControlId (static_cast<int> (newFocusId));
+
+    // Send hardware focus feedback
+    if (prev && *prev != newFocusId)
+        hardwareOutput.setFocus (*prev, false);
+    hardwareOutput.setFocus (newFocusId, true);
+}
+
+ui_core::ControlId ControlSurface::getFocusedControlId() const noexcept
+{
+    return focusedIndex >= 0 ? kControls[focusedIndex].id : 0;
+}
+
+void ControlSurface::syncFocusFromParameters()
+{
+    const auto index = findControlIndex (static_cast<ui_core::ControlId> (parameters.getFocusedControlId()));
+    if (index >= 0 && index != focusedIndex)
+        focusControl (index);
+}
+
+void ControlSurface::widgetFocusChanged (int index, bool focused)
+{
+    if (focused)
+        focusedIndex = index;
+    else if (focusedIndex == index)
+        focusedIndex = -1;
+
+    listeners.call ([this] (Listener& l) { l.controlFocusChanged (focusedIndex); });
+}
+
+int ControlSurface::findControlIndex (ui_core::ControlId controlId) const noexcept
+{
+    const auto it = controlIndexById.find (controlId);
+    return it != controlIndexById.end() ? it->second : -1;
+}
+
+//==============================================================================
+void ControlSurface::timerCallback()
+{
+    updateDisplayValues();
+    displays.flush (juce::Time::getMillisecondCounter());
+}
+
+void ControlSurface::updateDisplayValues()
+{
+    // Host automation, undo and state recall all land in Parameters, so poll
+    // it; formatting happens only for values that actually moved.
+    ui_core::DisplayText text;
+
+    for (const auto& control : kControls)
+    {
+        const auto value = parameters.getValue (control.parameter);
+        auto& last = lastDisplayedValue[(size_t) control.parameter];
+
+        if (value == last)
+            continue;
+
+        last = value;
+
+        const int decimals = control.interval >= 1.0f ? 0 : (control.interval >= 0.1f ? 1 : 2);
+        const auto& spec = Parameters::getSpec (control.parameter);
+        ui_core::formatDisplayValue (text, value, decimals, spec.label);
+        displays.setText (control.id, ui_core::kDisplayValueLine, text.data());
+    }
+}
+
+//==============================================================================
+void ControlSurface::setControlValue (int index, float native)
+{
+    parameters.setValue (kControls[index].parameter, native);
+    sendFeedback (index);
+}
+
+void ControlSurface::sendFeedback (int index)
+{
+    // Send LED feedback (convert native to normalized)
+    const auto parameter = kControls[index].parameter;
+    const auto& spec = Parameters::getSpec (parameter);
+    const auto normalized = (parameters.getValue (parameter) - spec.minValue) / (spec.maxValue - spec.minValue);
+    hardwareOutput.setLEDValue (kControls[index].id, normalized);
+
+    listeners.call ([index] (Listener& l) { l.controlValueChanged (index); });
+}
+
+void ControlSurface::beginGesture (int index)
+{
+    parameters.beginChangeGesture (kControls[index].parameter);
+}
+
+void ControlSurface::endGesture (int index)
+{
+    parameters.endChangeGesture (kControls[index].parameter);
+}
+
+void ControlSurface::undo()
+{
+    parameterRestored (parameters.undo());
+}
+
+void ControlSurface::redo()
+{
+    parameterRestored (parameters.redo());
+}
+
+void ControlSurface::parametersChanged (juce::uint32 parameterMask)
+{
+    for (int i = 0; i < Parameters::numHostParameters; ++i)
+        if ((parameterMask & (1u << i)) != 0)
+            parameterRestored (i);
+}
+
+void ControlSurface::parameterRestored (int parameterIndex)
+{
+    if (parameterIndex < 0)
+        return;
+
+    const auto index = controlIndexByParameter[(size_t) parameterIndex];
+    if (index >= 0)
+        sendFeedback (index);
+}
+
+void ControlSurface::toggleEventRecording()
+{
+    if (isRecordingEvents())
+    {
+        stopEventRecording();
+        return;
+    }
+
+    auto dir = juce::File::getSpecialLocation (juce::File::userDocumentsDirectory).getChildFile (JucePlugin_Name);
+    dir.createDirectory();
+
+    const auto name = "hw-" + juce::Time::getCurrentTime().formatted ("%Y%m%d-%H%M%S") + ".hwev";
+    startEventRecording (dir.getChildFile (name));
+}
+
+bool ControlSurface::startEventRecording (const juce::File& file)
+{
+    stopEventRecording();
+
+    eventRecorder = std::make_unique<HardwareEventRecorder> (file);
+
+    if (! eventRecorder->isOpen())
+    {
+        eventRecorder.reset();
+        return false;
+    }
+
+    hardwareAdapter.setRecorder (eventRecorder.get());
+    DBG ("HW capture started: " + file.getFullPathName());
+    return true;
+}
+
+void ControlSurface::stopEventRecording()
+{
+    if (eventRecorder == nullptr)
+        return;
+
+    hardwareAdapter.setRecorder (nullptr);
+    lastCapture = eventRecorder->getFile();
+    eventRecorder.reset();
+    DBG ("HW capture stopped: " + lastCapture.getFullPathName());
+}
+
+void ControlSurface::toggleEventPlayback()
+{
+    if (eventPlayer != nullptr && eventPlayer->isPlaying())
+    {
+        eventPlayer.reset();
+        return;
+    }
+
+    // Replaying into a running capture would record the replay too
+    stopEventRecording();
+
+    eventPlayer = std::make_unique<HardwareEventPlayer> (lastCapture);
+
+    if (! eventPlayer->isValid())
+    {
+        DBG ("HW replay: no capture to play");
+        eventPlayer.reset();
+        return;
+    }
+
+    DBG ("HW replay: " + juce::String (eventPlayer->getNumEvents()) + " events from " + lastCapture.getFullPathName());
+    eventPlayer->start (hardwareAdapter);
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include <ui_core/UiCore.h>
+#include "ControlIds.h"
+#include "HardwareEventPlayer.h"
+#include "HardwareEventRecorder.h"
+#include "OscInputBackend.h"
+#include "PluginHardwareAdapter.h"
+#include "PluginHardwareOutputAdapter.h"
+#include <array>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+//==============================================================================
+/**
+    Processor-scoped control state: bindings, focus and hardware I/O.
+
+    Lives as long as the plugin, so hardware keeps working with the editor
+    closed and opening an editor costs nothing here: no bindings rebuilt, no
+    focus or LED state re-sent. Editors attach as a Listener to hear about
+    focus and value changes, and detach when they close.
+
+    Each control also drives a two-line display (name, value). Value text is
+    reformatted only when the parameter moved and goes out through a
+    ui_core::DisplayDriver, so screens see changed text only, at most
+    kDisplayRefreshHz times a second.
+
+    Thread contract: message thread only, like everything it owns.
+*/
+class ControlSurface : private juce::Timer
+{
+public:
+    /** Feedback (LEDs, focus, displays) goes to output, which must outlive
+        this; nullptr uses the DBG-logging PluginHardwareOutputAdapter. */
+    explicit ControlSurface (Parameters& parametersToControl,
+                             ui_core::HardwareOutputAdapter* output = nullptr);
+    ~ControlSurface() override;
+
+    //==============================================================================
+    struct Listener
+    {
+        virtual ~Listener() = default;
+
+        /** Table index into kControls, or -1. */
+        virtual void controlFocusChanged (int index) = 0;
+        virtual void controlValueChanged (int index) = 0;
+    };
+
+    void addListener (Listener* listener)     { listeners.add (listener); }
+    void removeListener (Listener* listener)  { listeners.remove (listener); }
+
+    //==============================================================================
+    /** Entry point for every hardware source (MIDI queue, OSC, keys). */
+    ui_core::HardwareInputAdapter& getInputAdapter() noexcept  { return hardwareAdapter; }
+
+    void focusControl (int index);
+    int getFocusedIndex() const noexcept  { return focusedIndex; }
+    ui_core::ControlId getFocusedControlId() const noexcept;
+
+    /** Picks up a focus change that arrived through Parameters (state recall). */
+    void syncFocusFromParameters();
+
+    /** UI edits: parameter, LED feedback and listeners, as for hardware. */
+    void setControlValue (int index, float native);
+    void beginGesture (int index);
+    void endGesture (int index);
+
+    /** Parameter undo/redo (see UndoJournal), with LED feedback and listeners. */
+    void undo();
+    void redo();
+
+    /** LED feedback and listeners for parameters changed elsewhere (MIDI on
+        the audio thread): a bit per Parameters::Index, as returned by
+        Parameters::flushHostNotifications(). Displays follow on their own. */
+    void parametersChanged (juce::uint32 parameterMask);
+
+    /** Starts/stops capturing hardware events (see HardwareEventRecorder)
+        into a timestamped file under Documents/<plugin name>. */
+    void toggleEventRecording();
+
+    /** Captures every hardware event into file until stopEventRecording(). */
+    bool startEventRecording (const juce::File& file);
+    void stopEventRecording();
+    bool isRecordingEvents() const noexcept  { return eventRecorder != nullptr; }
+
+    /** Replays the last capture at its original timing through the same
+        input path as live hardware; again to stop. Stops recording first. */
+    void toggleEventPlayback();
+
+    //==============================================================================
+    static constexpr int kDisplayRefreshHz = 20;
+
+    /** Per-display send cap. Below the timer period: a cap equal to it would
+        skip every tick that fires a little early and drop towards half rate. */
+    static constexpr std::uint32_t kDisplayMinIntervalMs = 1000 / kDisplayRefreshHz * 3 / 4;
+
+private:
+    struct FocusFlagAdapter : ui_core::Focusable
+    {
+        ControlSurface* owner = nullptr;
+        int controlIndex = -1;
+
+        void setFocused (bool focused) override  { owner->widgetFocusChanged (controlIndex, focused); }
+    };
+
+    // PLUGIN_OSC_PORT and the ports after it, one per plugin instance
+    static constexpr int kOscPortsToTry = 8;
+
+    void timerCallback() override;
+    void updateDisplayValues();
+
+    void widgetFocusChanged (int index, bool focused);
+    void parameterRestored (int parameterIndex);
+    void sendFeedback (int index);
+    int findControlIndex (ui_core::ControlId controlId) const noexcept;
+
+    Parameters& parameters;
+
+    ui_core::FocusManager focusManager;
+    ui_core::BindingRegistry bindingRegistry;
+    PluginHardwareAdapter hardwareAdapter { bindingRegistry };
+    PluginHardwareOutputAdapter defaultOutput;
+    ui_core::HardwareOutputAdapter& hardwareOutput;
+    ui_core::DisplayDriver displays { hardwareOutput, kDisplayMinIntervalMs };
+    std::unique_ptr<HardwareEventRecorder> eventRecorder;
+    std::unique_ptr<HardwareEventPlayer> eventPlayer;
+    juce::File lastCapture;
+    std::unique_ptr<OscInputBackend> oscInput;
+
+    // One per kControls entry, never resized after construction
+    std::vector<FocusFlagAdapter> focusAdapters;
+    std::unordered_map<ui_core::ControlId, int> controlIndexById;
+    std::array<int, Parameters::numHostParameters> controlIndexByParameter;
+    std::array<float, Parameters::numHostParameters> lastDisplayedValue;
+    int focusedIndex = -1;
+
+    juce::ListenerList<Listener> listeners;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ControlSurface)
+};
@@ -0,0 +1,94 @@
+#include "HardwareEventPlayer.h"
+
+//==============================================================================
+HardwareEventPlayer::HardwareEventPlayer (const juce::File& file)
+{
+    mappedFile = std::make_unique<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readOnly);
+
+    const auto* data = static_cast<const juce::uint8*> (mappedFile->getData());
+    const auto size = static_cast<juce::int64> (mappedFile->getSize());
+
+    if (data == nullptr || size < HardwareEventRecorder::kHeaderSize
+         || std::memcmp (data, HardwareEventRecorder::kMagic, 4) != 0
+         || juce::ByteOrder::littleEndianInt (data + 4) != HardwareEventRecorder::kVersion)
+    {
+        mappedFile.reset();
+        return;
+    }
+
+    recordingStartTime = juce::Time (static_cast<juce::int64> (juce::ByteOrder::littleEndianInt64 (data + 8)));
+    records = data + HardwareEventRecorder::kHeaderSize;
+
+    // A capture cut short mid-record just loses its last partial record.
+    numEvents = static_cast<int> ((size - HardwareEventRecorder::kHeaderSize) / HardwareEventRecorder::kRecordSize);
+}
+
+HardwareEventPlayer::~HardwareEventPlayer()
+{
+    stop();
+}
+
+ui_core::HardwareControlEvent HardwareEventPlayer::getEvent (int index, juce::uint64& timestampMicros) const noexcept
+{
+    jassert (juce::isPositiveAndBelow (index, numEvents));
+
+    const auto* r = records + static_cast<size_t> (index) * HardwareEventRecorder::kRecordSize;
+    const auto stamp = juce::ByteOrder::littleEndianInt64 (r);
+
+    timestampMicros = stamp & ~HardwareEventRecorder::kRelativeFlag;
+
+    const auto valueBits = juce::ByteOrder::littleEndianInt (r + 12);
+    float value;
+    std::memcpy (&value, &valueBits, sizeof (value));
+
+    return { static_cast<ui_core::ControlId> (juce::ByteOrder::littleEndianInt (r + 8)),
+             value,
+             (stamp & HardwareEventRecorder::kRelativeFlag) != 0 };
+}
+
+//==============================================================================
+int HardwareEventPlayer::replayAll (ui_core::HardwareInputAdapter& target)
+{
+    juce::uint64 timestamp = 0;
+
+    for (int i = 0; i < numEvents; ++i)
+        target.processEvent (getEvent (i, timestamp));
+
+    return numEvents;
+}
+
+void HardwareEventPlayer::start (ui_core::HardwareInputAdapter& target)
+{
+    if (! isValid())
+        return;
+
+    playbackTarget = &target;
+    nextEvent = 0;
+    playbackStartTicks = juce::Time::getHighResolutionTicks();
+    startTimer (1);
+}
+
+void HardwareEventPlayer::stop()
+{
+    stopTimer();
+    playbackTarget = nullptr;
+}
+
+void HardwareEventPlayer::timerCallback()
+{
+    const auto elapsedMicros = static_cast<juce::uint64> (
+        juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - playbackStartTicks) * 1.0e6);
+
+    juce::uint64 timestamp = 0;
+    while (nextEvent < numEvents)
+    {
+        const auto event = getEvent (nextEvent, timestamp);
+        if (timestamp > elapsedMicros)
+            return;
+
+        playbackTarget->processEvent (event);
+        ++nextEvent;
+    }
+
+    stop();
+}
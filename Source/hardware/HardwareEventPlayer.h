@@ -0,0 +1,53 @@
+#pragma once
+
+#include "HardwareEventRecorder.h"
+#include <juce_events/juce_events.h>
+
+//==============================================================================
+/**
+    Replays a HardwareEventRecorder capture into any HardwareInputAdapter.
+
+    The file is memory-mapped, so opening is O(1) and events are decoded in
+    place. Two modes:
+    - replayAll(): every event back to back, as fast as possible
+      (load test for the binding path)
+    - start():     events at their original timing, driven by a timer on
+      the message thread (bug reproduction)
+*/
+class HardwareEventPlayer : private juce::Timer
+{
+public:
+    explicit HardwareEventPlayer (const juce::File& file);
+    ~HardwareEventPlayer() override;
+
+    bool isValid() const noexcept { return numEvents > 0; }
+    int getNumEvents() const noexcept { return numEvents; }
+
+    /** Wall-clock start of the capture, from the file header. */
+    juce::Time getRecordingStartTime() const noexcept { return recordingStartTime; }
+
+    ui_core::HardwareControlEvent getEvent (int index, juce::uint64& timestampMicros) const noexcept;
+
+    //==============================================================================
+    /** Feeds every event to target immediately. Returns the number sent. */
+    int replayAll (ui_core::HardwareInputAdapter& target);
+
+    /** Starts timed playback. target must outlive playback (or call stop()). */
+    void start (ui_core::HardwareInputAdapter& target);
+    void stop();
+    bool isPlaying() const noexcept { return isTimerRunning(); }
+
+private:
+    void timerCallback() override;
+
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
+    const juce::uint8* records = nullptr;
+    int numEvents = 0;
+    juce::Time recordingStartTime;
+
+    ui_core::HardwareInputAdapter* playbackTarget = nullptr;
+    int nextEvent = 0;
+    juce::int64 playbackStartTicks = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HardwareEventPlayer)
+};
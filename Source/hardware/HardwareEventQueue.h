@@ -0,0 +1,49 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <ui_core/UiCore.h>
+#include <vector>
+
+//==============================================================================
+/**
+    Single-producer / single-consumer queue of hardware events.
+
+    Lets a non-message thread (OSC socket, audio callback) hand events to the
+    message thread, where BindingRegistry lives. Storage is allocated once in
+    the constructor; push() and drain() never allocate or lock.
+    When full, push() drops the event and returns false.
+*/
+class HardwareEventQueue
+{
+public:
+    explicit HardwareEventQueue (int capacity)
+        : fifo (capacity + 1),
+          events (static_cast<size_t> (capacity + 1))
+    {
+    }
+
+    bool push (const ui_core::HardwareControlEvent& event) noexcept
+    {
+        const auto scope = fifo.write (1);
+        if (scope.blockSize1 == 0)
+            return false;
+
+        events[(size_t) scope.startIndex1] = event;
+        return true;
+    }
+
+    /** Calls fn (const HardwareControlEvent&) for every queued event. */
+    template <typename Fn>
+    int drain (Fn&& fn)
+    {
+        const auto scope = fifo.read (fifo.getNumReady());
+        scope.forEach ([&] (int index) { fn (events[(size_t) index]); });
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<ui_core::HardwareControlEvent> events;
+
+    JUCE_DECLARE_NON_COPYABLE (HardwareEventQueue)
+};
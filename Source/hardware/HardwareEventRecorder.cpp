@@ -0,0 +1,48 @@
+#include "HardwareEventRecorder.h"
+
+//==============================================================================
+HardwareEventRecorder::HardwareEventRecorder (const juce::File& fileToWrite)
+    : file (fileToWrite)
+{
+    file.deleteFile();
+    stream = std::make_unique<juce::FileOutputStream> (file);
+
+    if (stream->failedToOpen())
+    {
+        stream.reset();
+        return;
+    }
+
+    stream->write (kMagic, 4);
+    stream->writeInt (static_cast<int> (kVersion));
+    stream->writeInt64 (juce::Time::currentTimeMillis());
+
+    startTicks = juce::Time::getHighResolutionTicks();
+}
+
+HardwareEventRecorder::~HardwareEventRecorder()
+{
+    flush();
+}
+
+void HardwareEventRecorder::record (const ui_core::HardwareControlEvent& event)
+{
+    if (stream == nullptr)
+        return;
+
+    const auto elapsed = juce::Time::getHighResolutionTicks() - startTicks;
+    auto micros = static_cast<juce::uint64> (juce::Time::highResolutionTicksToSeconds (elapsed) * 1.0e6);
+
+    if (event.isRelative)
+        micros |= kRelativeFlag;
+
+    stream->writeInt64 (static_cast<juce::int64> (micros));
+    stream->writeInt (static_cast<int> (event.controlId));
+    stream->writeFloat (event.normalizedValue);
+}
+
+void HardwareEventRecorder::flush()
+{
+    if (stream != nullptr)
+        stream->flush();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <ui_core/UiCore.h>
+#include <memory>
+
+//==============================================================================
+/**
+    Captures hardware input events into a compact append-only binary file.
+
+    File layout (little-endian):
+        header  "HWEV", uint32 version, int64 wall-clock start (ms since epoch)
+        records 16 bytes each, in arrival order:
+                uint64 microseconds since start (top bit set = relative event)
+                uint32 controlId
+                float  normalizedValue
+
+    Records go through a buffered stream, so record() costs a few stores
+    and no system call in the common case. Message thread only.
+    Use HardwareEventPlayer to read a capture back.
+*/
+class HardwareEventRecorder
+{
+public:
+    /** Creates (or replaces) the capture file and writes the header. */
+    explicit HardwareEventRecorder (const juce::File& file);
+    ~HardwareEventRecorder();
+
+    bool isOpen() const noexcept { return stream != nullptr; }
+    const juce::File& getFile() const noexcept { return file; }
+
+    void record (const ui_core::HardwareControlEvent& event);
+    void flush();
+
+    //==============================================================================
+    static constexpr const char* kMagic = "HWEV";
+    static constexpr juce::uint32 kVersion = 1;
+    static constexpr int kHeaderSize = 16;
+    static constexpr int kRecordSize = 16;
+    static constexpr juce::uint64 kRelativeFlag = juce::uint64 (1) << 63;
+
+private:
+    juce::File file;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    juce::int64 startTicks = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HardwareEventRecorder)
+};
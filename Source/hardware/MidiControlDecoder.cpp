@@ -0,0 +1,213 @@
+#include "MidiControlDecoder.h"
+
+//==============================================================================
+bool MidiControlDecoder::decode (const juce::uint8* data, int numBytes, ui_core::HardwareControlEvent& event) noexcept
+{
+    if (numBytes < 3 || (data[0] & 0xf0) != 0xb0)
+        return false;
+
+    const int channel = data[0] & 0x0f;
+    const int cc = data[1] & 0x7f;
+    const auto value = static_cast<juce::uint8> (data[2] & 0x7f);
+    auto& s = channels[(size_t) channel];
+
+    switch (cc)
+    {
+        case 99:    s.nrpnMsb = value; s.nrpnNumber = -1; s.rpnSelected = false; return false;
+        case 98:    s.nrpnNumber = (s.nrpnMsb << 7) | value; s.rpnSelected = false; return false;
+        case 101:
+        case 100:   s.rpnSelected = true; return false;
+        case 6:
+            // Coarse value at once; a CC 38 that follows refines it
+            s.dataMsb = value;
+            if (s.rpnSelected || s.nrpnNumber < 0)
+                return false;
+
+            return resolve (Kind::nrpn, channel, s.nrpnNumber, static_cast<float> (value) / 127.0f, event);
+
+        case 38:
+            if (s.rpnSelected || s.nrpnNumber < 0)
+                return false;
+
+            return resolve (Kind::nrpn, channel, s.nrpnNumber,
+                            static_cast<float> ((s.dataMsb << 7) | value) / 16383.0f, event);
+
+        default:
+            break;
+    }
+
+    if (cc < 32)
+    {
+        s.ccMsb[(size_t) cc] = value;
+        s.ccMsbSeen |= 1u << cc;
+        return resolve (Kind::cc7, channel, cc, static_cast<float> (value) / 127.0f, event);
+    }
+
+    // An LSB only after its MSB; on its own, a 7-bit CC like any other
+    if (cc < 64 && (s.ccMsbSeen & (1u << (cc - 32))) != 0)
+    {
+        const int msb = s.ccMsb[(size_t) (cc - 32)];
+        return resolve (Kind::cc14, channel, cc - 32, static_cast<float> ((msb << 7) | value) / 16383.0f, event);
+    }
+
+    return resolve (Kind::cc7, channel, cc, static_cast<float> (value) / 127.0f, event);
+}
+
+bool MidiControlDecoder::resolve (Kind kind, int channel, int number, float value,
+                                  ui_core::HardwareControlEvent& event) noexcept
+{
+    const auto source = makeSource (kind, channel, number);
+
+    if (const auto target = learnTarget.load (std::memory_order_relaxed); target != 0)
+    {
+        // CC 0–31 may be the MSB of a 14-bit pair: wait for the next message.
+        if (kind == Kind::cc7 && number < 32 && pendingLearnSource != source)
+        {
+            pendingLearnSource = source;
+            return false;
+        }
+
+        // The table belongs to the message thread; hand the result over
+        pendingLearnSource = 0;
+        learnedMapping.store (pack (source, target));
+        learnTarget.store (0);
+    }
+
+    // Until applied, a learned source wins over whatever the table says
+    if (const auto learned = learnedMapping.load (std::memory_order_relaxed);
+        learned != 0 && static_cast<juce::uint32> (learned >> 32) == source)
+    {
+        event = { static_cast<ui_core::ControlId> (learned & 0xffffffffu), value, false };
+        return true;
+    }
+
+    for (const auto& slot : mappings)
+    {
+        const auto packed = slot.load (std::memory_order_relaxed);
+        if (static_cast<juce::uint32> (packed >> 32) == source)
+        {
+            event = { static_cast<ui_core::ControlId> (packed & 0xffffffffu), value, false };
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void MidiControlDecoder::storeMapping (juce::uint32 source, ui_core::ControlId controlId)
+{
+    // One source per control and one control per source: drop both first.
+    for (auto& slot : mappings)
+    {
+        const auto packed = slot.load (std::memory_order_relaxed);
+        if (packed != 0 && (static_cast<juce::uint32> (packed >> 32) == source
+                             || static_cast<ui_core::ControlId> (packed & 0xffffffffu) == controlId))
+            slot.store (0);
+    }
+
+    for (auto& slot : mappings)
+    {
+        if (slot.load (std::memory_order_relaxed) == 0)
+        {
+            slot.store (pack (source, controlId));
+            break;
+        }
+    }
+
+    mappingsChanged.store (true);
+}
+
+bool MidiControlDecoder::applyLearnedMapping()
+{
+    const auto learned = learnedMapping.load();
+    if (learned == 0)
+        return false;
+
+    storeMapping (static_cast<juce::uint32> (learned >> 32), static_cast<ui_core::ControlId> (learned & 0xffffffffu));
+
+    // Only clear the slot if the audio thread hasn't learned again meanwhile
+    auto expected = learned;
+    learnedMapping.compare_exchange_strong (expected, 0);
+    return true;
+}
+
+//==============================================================================
+void MidiControlDecoder::addMapping (Kind kind, int channel, int number, ui_core::ControlId controlId)
+{
+    applyLearnedMapping();
+    storeMapping (makeSource (kind, channel, number), controlId);
+}
+
+void MidiControlDecoder::removeMappingsFor (ui_core::ControlId controlId)
+{
+    applyLearnedMapping();
+
+    for (auto& slot : mappings)
+        if (static_cast<ui_core::ControlId> (slot.load() & 0xffffffffu) == controlId)
+            slot.store (0);
+
+    mappingsChanged.store (true);
+}
+
+void MidiControlDecoder::clearMappings()
+{
+    learnedMapping.store (0);
+
+    for (auto& slot : mappings)
+        slot.store (0);
+
+    mappingsChanged.store (true);
+}
+
+void MidiControlDecoder::startLearn (ui_core::ControlId controlId)
+{
+    // The hand-over slot holds one result: make room for the next
+    applyLearnedMapping();
+    learnTarget.store (controlId);
+}
+
+void MidiControlDecoder::cancelLearn() noexcept
+{
+    learnTarget.store (0);
+}
+
+//==============================================================================
+void MidiControlDecoder::getState (juce::ValueTree& state) const
+{
+    juce::ValueTree midiState ("MidiMappings");
+
+    for (const auto& slot : mappings)
+    {
+        const auto packed = slot.load();
+        if (packed == 0)
+            continue;
+
+        const auto source = static_cast<juce::uint32> (packed >> 32);
+
+        juce::ValueTree mapping ("Mapping");
+        mapping.setProperty ("kind",      static_cast<int> ((source >> 20) & 0x3),  nullptr);
+        mapping.setProperty ("channel",   static_cast<int> ((source >> 16) & 0x0f), nullptr);
+        mapping.setProperty ("number",    static_cast<int> (source & 0x3fff),       nullptr);
+        mapping.setProperty ("controlId", static_cast<juce::int64> (packed & 0xffffffffu), nullptr);
+        midiState.appendChild (mapping, nullptr);
+    }
+
+    state.appendChild (midiState, nullptr);
+}
+
+void MidiControlDecoder::setState (const juce::ValueTree& state)
+{
+    clearMappings();
+
+    for (const auto& mapping : state.getChildWithName ("MidiMappings"))
+    {
+        const auto kind = static_cast<int> (mapping.getProperty ("kind", 0));
+        if (kind > static_cast<int> (Kind::nrpn))
+            continue;
+
+        addMapping (static_cast<Kind> (kind),
+                    static_cast<int> (mapping.getProperty ("channel", 0)),
+                    static_cast<int> (mapping.getProperty ("number", 0)),
+                    static_cast<ui_core::ControlId> (static_cast<juce::int64> (mapping.getProperty ("controlId", 0))));
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_data_structures/juce_data_structures.h>
+#include <ui_core/UiCore.h>
+#include <array>
+#include <atomic>
+
+//==============================================================================
+/**
+    Decodes MIDI controllers into HardwareControlEvents on the audio thread.
+
+    Supports plain 7-bit CC, 14-bit CC (MSB 0–31 + LSB 32–63) and NRPN
+    (99/98 select, 6/38 data entry). 14-bit CCs are emitted when their LSB
+    arrives, so a controller update never jumps through its MSB alone. A CC
+    32–63 only counts as an LSB once its MSB has been seen on that channel;
+    until then it is a 7-bit CC of its own. NRPN
+    data entry is emitted on CC 6 as a 7-bit value, since many controllers
+    never send CC 38, and refined to 14 bits when a CC 38 follows.
+
+    The mapping table is a fixed array of packed atomics. The audio thread
+    only reads it, without locks or allocation; the message thread is its
+    only writer (edits, state recall and applying learn results).
+
+    Learn mode: startLearn (id) on the message thread, then the next
+    controller that moves is learned for id. A CC 0–31 is only committed once
+    it is clear whether it is a 7-bit CC (same CC again) or the MSB of a
+    14-bit pair (matching LSB follows). The audio thread uses a learned
+    source straight away; applyLearnedMapping() writes it into the table.
+*/
+class MidiControlDecoder
+{
+public:
+    enum class Kind : juce::uint32
+    {
+        cc7  = 0,
+        cc14 = 1,
+        nrpn = 2
+    };
+
+    static constexpr int kMaxMappings = 64;
+
+    MidiControlDecoder() = default;
+
+    //==============================================================================
+    /** Audio thread. Calls onEvent (int samplePosition, const HardwareControlEvent&)
+        for every mapped controller message in the buffer, in time order. */
+    template <typename Callback>
+    void process (const juce::MidiBuffer& midi, Callback&& onEvent) noexcept
+    {
+        for (const auto metadata : midi)
+        {
+            ui_core::HardwareControlEvent event;
+            if (decode (metadata.data, metadata.numBytes, event))
+                onEvent (metadata.samplePosition, event);
+        }
+    }
+
+    //==============================================================================
+    // Message thread
+    void addMapping (Kind kind, int channel, int number, ui_core::ControlId controlId);
+    void removeMappingsFor (ui_core::ControlId controlId);
+    void clearMappings();
+
+    void startLearn (ui_core::ControlId controlId);
+    void cancelLearn() noexcept;
+    ui_core::ControlId getLearnTarget() const noexcept { return learnTarget.load(); }
+
+    /** Moves a mapping learned on the audio thread into the table. Call
+        regularly (e.g. from a timer); returns true if there was one. */
+    bool applyLearnedMapping();
+
+    /** True if the table changed (learn, edit, load) since the last call. */
+    bool consumeMappingChange() noexcept { return mappingsChanged.exchange (false); }
+
+    void getState (juce::ValueTree& state) const;
+    void setState (const juce::ValueTree& state);
+
+private:
+    bool decode (const juce::uint8* data, int numBytes, ui_core::HardwareControlEvent& event) noexcept;
+    bool resolve (Kind kind, int channel, int number, float value, ui_core::HardwareControlEvent& event) noexcept;
+    void storeMapping (juce::uint32 source, ui_core::ControlId controlId);
+
+    static juce::uint64 pack (juce::uint32 source, ui_core::ControlId controlId) noexcept
+    {
+        return (static_cast<juce::uint64> (source) << 32) | controlId;
+    }
+
+    // Packed source: valid bit | kind << 20 | channel << 16 | number (14 bit)
+    static juce::uint32 makeSource (Kind kind, int channel, int number) noexcept
+    {
+        return 0x80000000u | (static_cast<juce::uint32> (kind) << 20)
+                           | (static_cast<juce::uint32> (channel & 0x0f) << 16)
+                           | static_cast<juce::uint32> (number & 0x3fff);
+    }
+
+    struct ChannelState
+    {
+        std::array<juce::uint8, 32> ccMsb {};
+        juce::uint32 ccMsbSeen = 0; // bit per CC 0–31 received
+        int nrpnNumber = -1;        // -1 until both 99 and 98 arrived
+        juce::uint8 nrpnMsb = 0;
+        juce::uint8 dataMsb = 0;
+        bool rpnSelected = false;   // data entry belongs to an RPN, not ours
+    };
+
+    std::array<ChannelState, 16> channels {};
+
+    // Each slot: source << 32 | controlId, or 0 when empty. Message thread writes.
+    std::array<std::atomic<juce::uint64>, kMaxMappings> mappings {};
+
+    std::atomic<ui_core::ControlId> learnTarget { 0 };
+    juce::uint32 pendingLearnSource = 0;   // audio thread only
+
+    // Audio -> message thread: the last learn result until applied, or 0
+    std::atomic<juce::uint64> learnedMapping { 0 };
+    std::atomic<bool> mappingsChanged { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MidiControlDecoder)
+};
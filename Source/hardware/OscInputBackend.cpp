@@ -0,0 +1,260 @@
+#include "OscInputBackend.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // OSC strings are null-terminated and padded to a multiple of 4 bytes.
+    int paddedSize (int bytesIncludingTerminator) noexcept
+    {
+        return (bytesIncludingTerminator + 3) & ~3;
+    }
+
+    // Length of a null-terminated string inside [data, data + size), or -1.
+    int boundedLength (const char* data, int size) noexcept
+    {
+        if (auto* end = static_cast<const char*> (std::memchr (data, 0, static_cast<size_t> (size))))
+            return static_cast<int> (end - data);
+
+        return -1;
+    }
+}
+
+//==============================================================================
+OscInputBackend::OscInputBackend (ui_core::HardwareInputAdapter& target)
+    : juce::Thread ("OSC Input"),
+      targetAdapter (target)
+{
+}
+
+OscInputBackend::~OscInputBackend()
+{
+    stop();
+}
+
+void OscInputBackend::addAddress (const juce::String& address, ui_core::ControlId controlId, bool isRelative)
+{
+    // The table is read lock-free by the receive thread.
+    jassert (! isThreadRunning());
+
+    const auto utf8 = address.toRawUTF8();
+    const auto length = static_cast<int> (std::strlen (utf8));
+    jassert (length > 0 && length < kMaxAddressLength);
+
+    AddressEntry entry;
+    entry.hash = hashAddress (utf8, length);
+    entry.controlId = controlId;
+    entry.isRelative = isRelative;
+    std::memcpy (entry.address, utf8, static_cast<size_t> (juce::jmin (length, kMaxAddressLength - 1)));
+
+    addressTable.push_back (entry);
+    std::sort (addressTable.begin(), addressTable.end(),
+               [] (const AddressEntry& a, const AddressEntry& b) { return a.hash < b.hash; });
+}
+
+bool OscInputBackend::start (int port, const juce::String& bindAddress, int numPortsToTry)
+{
+    stop();
+
+    // A second plugin instance finds the first port taken
+    for (int offset = 0; offset < juce::jmax (1, numPortsToTry); ++offset)
+    {
+        socket = std::make_unique<juce::DatagramSocket> (false);
+
+        const bool bound = bindAddress.isEmpty() ? socket->bindToPort (port + offset)
+                                                 : socket->bindToPort (port + offset, bindAddress);
+        if (bound)
+        {
+            boundPort = socket->getBoundPort();
+            startThread();
+            return true;
+        }
+
+        if (port == 0)
+            break;
+    }
+
+    socket.reset();
+    return false;
+}
+
+void OscInputBackend::stop()
+{
+    if (socket != nullptr)
+    {
+        signalThreadShouldExit();
+        socket->shutdown();
+        stopThread (1000);
+        socket.reset();
+        boundPort = 0;
+    }
+
+    cancelPendingUpdate();
+}
+
+//==============================================================================
+void OscInputBackend::run()
+{
+    while (! threadShouldExit())
+    {
+        const int ready = socket->waitUntilReady (true, 100);
+        if (ready < 0)
+            break;
+
+        if (ready == 0)
+            continue;
+
+        const int bytes = socket->read (packetBuffer.data(), static_cast<int> (packetBuffer.size()), false);
+        if (bytes <= 0)
+            continue;
+
+        numReceived.fetch_add (1, std::memory_order_relaxed);
+
+        if (bytes > kMaxPacketSize || ! parsePacket (packetBuffer.data(), bytes, 0))
+            numRejected.fetch_add (1, std::memory_order_relaxed);
+
+        triggerAsyncUpdate();
+    }
+}
+
+void OscInputBackend::handleAsyncUpdate()
+{
+    queue.drain ([this] (const ui_core::HardwareControlEvent& event) { targetAdapter.processEvent (event); });
+}
+
+//==============================================================================
+bool OscInputBackend::parsePacket (const char* data, int size, int depth) noexcept
+{
+    // "#bundle\0", 8-byte time tag, then (int32 size, element) pairs.
+    // Time tags are ignored: events apply on arrival.
+    if (size >= 8 && std::memcmp (data, "#bundle", 8) == 0)
+    {
+        if (size < 16 || depth >= kMaxBundleDepth)
+            return false;
+
+        for (int pos = 16; pos < size;)
+        {
+            if (size - pos < 4)
+                return false;
+
+            const auto elementSize = static_cast<int> (juce::ByteOrder::bigEndianInt (data + pos));
+            pos += 4;
+
+            if (elementSize <= 0 || elementSize > size - pos || (elementSize & 3) != 0)
+                return false;
+
+            if (! parsePacket (data + pos, elementSize, depth + 1))
+                return false;
+
+            pos += elementSize;
+        }
+
+        return true;
+    }
+
+    return parseMessage (data, size);
+}
+
+bool OscInputBackend::parseMessage (const char* data, int size) noexcept
+{
+    const int addressLength = boundedLength (data, size);
+    if (addressLength <= 0 || data[0] != '/')
+        return false;
+
+    // Not ours: well-formed, just unmapped
+    const auto* entry = findAddress (data, addressLength, hashAddress (data, addressLength));
+    if (entry == nullptr)
+        return true;
+
+    int pos = paddedSize (addressLength + 1);
+    if (pos >= size || data[pos] != ',')
+        return false;
+
+    const int tagsLength = boundedLength (data + pos, size - pos);
+    if (tagsLength < 2)
+        return false;
+
+    const char tag = data[pos + 1];
+    pos += paddedSize (tagsLength + 1);
+
+    const auto bytesLeft = size - pos;
+    float value = 0.0f;
+
+    switch (tag)
+    {
+        case 'f':
+        {
+            if (bytesLeft < 4)
+                return false;
+
+            const auto bits = juce::ByteOrder::bigEndianInt (data + pos);
+            std::memcpy (&value, &bits, sizeof (value));
+            break;
+        }
+
+        case 'i':
+            if (bytesLeft < 4)
+                return false;
+
+            value = static_cast<float> (static_cast<juce::int32> (juce::ByteOrder::bigEndianInt (data + pos)));
+            break;
+
+        case 'd':
+        {
+            if (bytesLeft < 8)
+                return false;
+
+            const auto bits = juce::ByteOrder::bigEndianInt64 (data + pos);
+            double d;
+            std::memcpy (&d, &bits, sizeof (d));
+            value = static_cast<float> (d);
+            break;
+        }
+
+        case 'T':   value = 1.0f; break;
+        case 'F':   value = 0.0f; break;
+        default:    return false;
+    }
+
+    // NaN would pass every clamp downstream and end up in the DSP; doubles
+    // beyond float range arrive here as inf
+    if (! std::isfinite (value))
+        return false;
+
+    if (! entry->isRelative)
+        value = juce::jlimit (0.0f, 1.0f, value);
+
+    if (! queue.push ({ entry->controlId, value, entry->isRelative }))
+        numDropped.fetch_add (1, std::memory_order_relaxed);
+
+    return true;
+}
+
+//==============================================================================
+const OscInputBackend::AddressEntry* OscInputBackend::findAddress (const char* address, int length,
+                                                                   juce::uint32 hash) const noexcept
+{
+    if (length >= kMaxAddressLength)
+        return nullptr;
+
+    auto it = std::lower_bound (addressTable.begin(), addressTable.end(), hash,
+                                [] (const AddressEntry& e, juce::uint32 h) { return e.hash < h; });
+
+    for (; it != addressTable.end() && it->hash == hash; ++it)
+        if (std::strncmp (it->address, address, static_cast<size_t> (length)) == 0 && it->address[length] == 0)
+            return &*it;
+
+    return nullptr;
+}
+
+juce::uint32 OscInputBackend::hashAddress (const char* address, int length) noexcept
+{
+    // FNV-1a
+    juce::uint32 hash = 2166136261u;
+
+    for (int i = 0; i < length; ++i)
+        hash = (hash ^ static_cast<juce::uint8> (address[i])) * 16777619u;
+
+    return hash;
+}
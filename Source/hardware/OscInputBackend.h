@@ -0,0 +1,102 @@
+#pragma once
+
+#include <juce_events/juce_events.h>
+#include <ui_core/UiCore.h>
+#include "HardwareEventQueue.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+//==============================================================================
+/**
+    OSC-over-UDP hardware input source.
+
+    A dedicated thread receives datagrams into a fixed buffer, parses messages
+    and nested bundles in place (no allocation, no juce::String), looks the
+    address up in a precomputed hash table and queues a HardwareControlEvent.
+    The message thread then forwards queued events to the target adapter.
+
+    Each mapped address takes the first numeric argument (i, f, d, T, F) as a
+    normalized 0..1 value (clamped), or as a normalized delta for relative
+    mappings. NaN and infinite values are dropped here, before they can reach
+    a parameter. Truncated or oversized packets, bundles nested deeper than
+    kMaxBundleDepth and messages without a numeric first argument are counted
+    as rejected.
+
+    Usage (message thread):
+        osc.addAddress ("/gain", kGainControlId);
+        osc.addAddress ("/gain/delta", kGainControlId, true);
+        osc.start (9001);
+*/
+class OscInputBackend : private juce::Thread,
+                        private juce::AsyncUpdater
+{
+public:
+    explicit OscInputBackend (ui_core::HardwareInputAdapter& target);
+    ~OscInputBackend() override;
+
+    /** Maps an OSC address to a control. Call before start(). */
+    void addAddress (const juce::String& address, ui_core::ControlId controlId, bool isRelative = false);
+
+    /** Binds the first free UDP port of port .. port + numPortsToTry - 1 and
+        starts receiving; port 0 lets the system pick one. An empty
+        bindAddress listens on all interfaces. False if none could be bound. */
+    bool start (int port, const juce::String& bindAddress = "127.0.0.1", int numPortsToTry = 1);
+    void stop();
+
+    bool isRunning() const noexcept { return isThreadRunning(); }
+
+    /** The port start() bound, or 0 when stopped. */
+    int getPort() const noexcept { return boundPort; }
+
+    /** Forwards queued events to the target now instead of on the next
+        message loop pass (message thread). */
+    void deliverPendingEvents()  { handleUpdateNowIfNeeded(); }
+
+    /** Datagrams read. */
+    juce::uint32 getNumReceived() const noexcept { return numReceived.load(); }
+    /** Well-formed events lost to a full queue. */
+    juce::uint32 getNumDropped() const noexcept { return numDropped.load(); }
+    /** Malformed packets and messages, and non-finite values. */
+    juce::uint32 getNumRejected() const noexcept { return numRejected.load(); }
+
+    //==============================================================================
+    static constexpr int kMaxAddressLength = 64;
+    static constexpr int kMaxPacketSize = 8192;
+    static constexpr int kMaxBundleDepth = 8;
+
+private:
+    void run() override;
+    void handleAsyncUpdate() override;
+
+    /** False if data (or any part of a bundle) was malformed. */
+    bool parsePacket (const char* data, int size, int depth) noexcept;
+    bool parseMessage (const char* data, int size) noexcept;
+
+    struct AddressEntry
+    {
+        juce::uint32 hash = 0;
+        ui_core::ControlId controlId = 0;
+        bool isRelative = false;
+        char address[kMaxAddressLength] {};
+    };
+
+    const AddressEntry* findAddress (const char* address, int length, juce::uint32 hash) const noexcept;
+    static juce::uint32 hashAddress (const char* address, int length) noexcept;
+
+    ui_core::HardwareInputAdapter& targetAdapter;
+    std::vector<AddressEntry> addressTable;   // sorted by hash, frozen while running
+
+    std::unique_ptr<juce::DatagramSocket> socket;
+    int boundPort = 0;
+
+    // One byte spare: a read that fills it came from an oversized datagram
+    std::array<char, kMaxPacketSize + 1> packetBuffer {};
+
+    HardwareEventQueue queue { 4096 };
+    std::atomic<juce::uint32> numReceived { 0 };
+    std::atomic<juce::uint32> numDropped { 0 };
+    std::atomic<juce::uint32> numRejected { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OscInputBackend)
+};
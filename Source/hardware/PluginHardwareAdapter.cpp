@@ -6,10 +6,20 @@ PluginHardwareAdapter::PluginHardwareAdapter (ui_core::BindingRegistry& registry
 {
 }
 
+PluginHardwareAdapter::~PluginHardwareAdapter()
+{
+    endAllGestures();
+}
+
 void PluginHardwareAdapter::processEvent (const ui_core::HardwareControlEvent& event)
 {
+    if (recorder != nullptr)
+        recorder->record (event);
+
     if (auto* binding = bindingRegistry.find (event.controlId))
     {
+        touchGesture (*binding);
+
         if (event.isRelative)
         {
             // Relative event: add delta to current normalized value (0..1)
@@ -24,3 +34,63 @@ void PluginHardwareAdapter::processEvent (const ui_core::HardwareControlEvent& e
         }
     }
 }
+
+void PluginHardwareAdapter::endAllGestures()
+{
+    while (numOpenGestures > 0)
+        endGestureAt (numOpenGestures - 1);
+
+    stopTimer();
+}
+
+//==============================================================================
+void PluginHardwareAdapter::touchGesture (ui_core::ParameterBinding& binding)
+{
+    const auto now = juce::Time::getMillisecondCounter();
+
+    for (int i = 0; i < numOpenGestures; ++i)
+    {
+        if (openGestures[(size_t) i].controlId == binding.controlId)
+        {
+            openGestures[(size_t) i].lastEventMs = now;
+            return;
+        }
+    }
+
+    // Table full: close the oldest gesture to make room.
+    if (numOpenGestures == kMaxOpenGestures)
+        endGestureAt (0);
+
+    binding.beginGesture();
+    openGestures[(size_t) numOpenGestures++] = { binding.controlId, now };
+
+    if (! isTimerRunning())
+        startTimer (static_cast<int> (kGestureIdleMs / 2));
+}
+
+void PluginHardwareAdapter::endGestureAt (int slot)
+{
+    const auto controlId = openGestures[(size_t) slot].controlId;
+
+    // Keep slots in open order so slot 0 is always the oldest.
+    std::move (openGestures.begin() + slot + 1,
+               openGestures.begin() + numOpenGestures,
+               openGestures.begin() + slot);
+    --numOpenGestures;
+
+    // The binding may have been removed since the gesture began.
+    if (auto* binding = bindingRegistry.find (controlId))
+        binding->endGesture();
+}
+
+void PluginHardwareAdapter::timerCallback()
+{
+    const auto now = juce::Time::getMillisecondCounter();
+
+    for (int i = numOpenGestures; --i >= 0;)
+        if (now - openGestures[(size_t) i].lastEventMs >= kGestureIdleMs)
+            endGestureAt (i);
+
+    if (numOpenGestures == 0)
+        stopTimer();
+}
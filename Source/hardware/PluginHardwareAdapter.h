@@ -1,20 +1,52 @@
 #pragma once
 
 #include <ui_core/UiCore.h>
+#include <juce_events/juce_events.h>
+#include "HardwareEventRecorder.h"
 #include <algorithm>
+#include <array>
 
 //==============================================================================
 /**
     Hardware input adapter that routes events to BindingRegistry.
+
+    Encoders and faders don't report touch/release, so a burst of events for
+    one control is bracketed as a single host gesture. The gesture closes once
+    the control has been idle for kGestureIdleMs.
 */
-class PluginHardwareAdapter : public ui_core::HardwareInputAdapter
+class PluginHardwareAdapter : public ui_core::HardwareInputAdapter,
+                              private juce::Timer
 {
 public:
     explicit PluginHardwareAdapter (ui_core::BindingRegistry& registry);
-    ~PluginHardwareAdapter() override = default;
+    ~PluginHardwareAdapter() override;
 
     void processEvent (const ui_core::HardwareControlEvent& event) override;
 
+    /** Ends every open gesture now (e.g. before bindings are torn down). */
+    void endAllGestures();
+
+    /** Captures every incoming event while set. Pass nullptr to stop.
+        The recorder must outlive its use here. */
+    void setRecorder (HardwareEventRecorder* newRecorder) noexcept { recorder = newRecorder; }
+
 private:
+    void timerCallback() override;
+    void touchGesture (ui_core::ParameterBinding& binding);
+    void endGestureAt (int slot);
+
+    static constexpr juce::uint32 kGestureIdleMs = 250;
+    static constexpr int kMaxOpenGestures = 8;
+
+    struct OpenGesture
+    {
+        ui_core::ControlId controlId = 0;
+        juce::uint32 lastEventMs = 0;
+    };
+
+    std::array<OpenGesture, kMaxOpenGestures> openGestures {};
+    int numOpenGestures = 0;
+
     ui_core::BindingRegistry& bindingRegistry;
+    HardwareEventRecorder* recorder = nullptr;
 };
@@ -11,3 +11,8 @@ void PluginHardwareOutputAdapter::setFocus (ui_core::ControlId controlId, bool f
 {
     DBG ("HW OUT FOCUS id=" + juce::String (controlId) + " focused=" + juce::String (focused ? 1 : 0));
 }
+
+void PluginHardwareOutputAdapter::setDisplayText (ui_core::ControlId displayId, int line, const char* text)
+{
+    DBG ("HW OUT DISPLAY id=" + juce::String (displayId) + " line=" + juce::String (line) + " text=" + juce::String (text));
+}
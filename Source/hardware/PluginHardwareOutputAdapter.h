@@ -15,4 +15,5 @@ public:
 
     void setLEDValue (ui_core::ControlId controlId, float normalized) override;
     void setFocus (ui_core::ControlId controlId, bool focused) override;
+    void setDisplayText (ui_core::ControlId displayId, int line, const char* text) override;
 };
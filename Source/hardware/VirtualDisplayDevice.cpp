@@ -0,0 +1,95 @@
+#include "VirtualDisplayDevice.h"
+
+//==============================================================================
+VirtualDisplayDevice::VirtualDisplayDevice (int maxDisplays, ui_core::HardwareOutputAdapter* inner)
+    : innerAdapter (inner)
+{
+    screens.reserve (static_cast<size_t> (juce::jmax (1, maxDisplays)));
+}
+
+VirtualDisplayDevice::~VirtualDisplayDevice()
+{
+    if (log != nullptr)
+        log->flush();
+}
+
+bool VirtualDisplayDevice::setLogFile (const juce::File& file)
+{
+    log.reset();
+
+    if (file == juce::File())
+        return true;
+
+    auto stream = std::make_unique<juce::FileOutputStream> (file);
+    if (! stream->openedOk())
+        return false;
+
+    log = std::move (stream);
+    return true;
+}
+
+//==============================================================================
+void VirtualDisplayDevice::setLEDValue (ui_core::ControlId controlId, float normalized)
+{
+    if (innerAdapter != nullptr)
+        innerAdapter->setLEDValue (controlId, normalized);
+}
+
+void VirtualDisplayDevice::setFocus (ui_core::ControlId controlId, bool focused)
+{
+    if (innerAdapter != nullptr)
+        innerAdapter->setFocus (controlId, focused);
+}
+
+void VirtualDisplayDevice::setDisplayText (ui_core::ControlId displayId, int line, const char* text)
+{
+    if (line < 0 || line >= ui_core::kDisplayLines)
+        return;
+
+    auto* screen = find (displayId);
+
+    if (screen == nullptr)
+    {
+        // A real device has a fixed number of screens too
+        if (screens.size() == screens.capacity())
+            return;
+
+        screens.push_back ({ displayId, {} });
+        screen = &screens.back();
+    }
+
+    ui_core::copyDisplayText (screen->lines[(size_t) line], text);
+    ++numSends;
+
+    if (log != nullptr)
+        *log << juce::String (juce::Time::getMillisecondCounter()) << ' '
+             << juce::String (displayId) << ':' << juce::String (line) << ' '
+             << juce::String (text) << juce::newLine;
+}
+
+const char* VirtualDisplayDevice::getText (ui_core::ControlId displayId, int line) const noexcept
+{
+    const auto* screen = find (displayId);
+    if (screen == nullptr || line < 0 || line >= ui_core::kDisplayLines)
+        return nullptr;
+
+    return screen->lines[(size_t) line].data();
+}
+
+VirtualDisplayDevice::Screen* VirtualDisplayDevice::find (ui_core::ControlId displayId) noexcept
+{
+    for (auto& screen : screens)
+        if (screen.id == displayId)
+            return &screen;
+
+    return nullptr;
+}
+
+const VirtualDisplayDevice::Screen* VirtualDisplayDevice::find (ui_core::ControlId displayId) const noexcept
+{
+    for (const auto& screen : screens)
+        if (screen.id == displayId)
+            return &screen;
+
+    return nullptr;
+}
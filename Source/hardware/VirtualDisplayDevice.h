@@ -0,0 +1,57 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <ui_core/UiCore.h>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+    Stand-in for a control surface with small text displays.
+
+    Keeps the last text of every display line in fixed buffers and counts
+    sends, so DisplayDriver behaviour (diffing, rate cap) can be checked
+    without hardware. Optionally appends each send to a text file as
+    "<ms> <displayId>:<line> <text>", one per line.
+
+    LED and focus calls are forwarded to an optional inner adapter, so it
+    can be slotted in front of a real backend.
+
+    Thread contract: message thread only, like DisplayDriver.
+*/
+class VirtualDisplayDevice : public ui_core::HardwareOutputAdapter
+{
+public:
+    explicit VirtualDisplayDevice (int maxDisplays, ui_core::HardwareOutputAdapter* inner = nullptr);
+    ~VirtualDisplayDevice() override;
+
+    /** Appends every send to file; an empty File stops logging. */
+    bool setLogFile (const juce::File& file);
+
+    void setLEDValue (ui_core::ControlId controlId, float normalized) override;
+    void setFocus (ui_core::ControlId controlId, bool focused) override;
+    void setDisplayText (ui_core::ControlId displayId, int line, const char* text) override;
+
+    /** Current text of a line, or nullptr if that display never received any. */
+    const char* getText (ui_core::ControlId displayId, int line) const noexcept;
+
+    int getNumSends() const noexcept  { return numSends; }
+
+private:
+    struct Screen
+    {
+        ui_core::ControlId id = 0;
+        std::array<ui_core::DisplayText, ui_core::kDisplayLines> lines {};
+    };
+
+    Screen* find (ui_core::ControlId displayId) noexcept;
+    const Screen* find (ui_core::ControlId displayId) const noexcept;
+
+    ui_core::HardwareOutputAdapter* innerAdapter;
+    std::vector<Screen> screens;      // capacity fixed at construction
+    int numSends = 0;
+
+    std::unique_ptr<juce::FileOutputStream> log;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (VirtualDisplayDevice)
+};
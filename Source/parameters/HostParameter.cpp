@@ -0,0 +1,41 @@
+#include "HostParameter.h"
+
+//==============================================================================
+HostParameter::HostParameter (const juce::ParameterID& parameterId,
+                              const juce::String& parameterName,
+                              std::atomic<float>& target,
+                              std::atomic<bool>& stateChangedFlag,
+                              float minValue,
+                              float maxValue,
+                              float defaultNativeValue,
+                              const juce::String& unitLabel)
+    : AudioProcessorParameterWithID (parameterId, parameterName),
+      value (target),
+      stateChanged (stateChangedFlag),
+      start (minValue),
+      length (maxValue - minValue),
+      defaultValue (defaultNativeValue),
+      label (unitLabel)
+{
+    jassert (length > 0.0f);
+}
+
+float HostParameter::getDefaultValue() const
+{
+    return toNormalised (defaultValue);
+}
+
+juce::String HostParameter::getLabel() const
+{
+    return label;
+}
+
+juce::String HostParameter::getText (float normalisedValue, int maximumStringLength) const
+{
+    return juce::String (toNative (normalisedValue), 2).substring (0, maximumStringLength);
+}
+
+float HostParameter::getValueForText (const juce::String& text) const
+{
+    return juce::jlimit (0.0f, 1.0f, toNormalised (text.getFloatValue()));
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
+
+//==============================================================================
+/**
+    Thin host-facing view of one Parameters atomic.
+
+    No ValueTree, no value cache, no listener list of its own: getValue() is
+    a single atomic load plus a linear 0..1 mapping; setValue() is the
+    matching exchange, raising the owner's state-changed flag only if the
+    value actually moved (hosts resend unchanged automation every block).
+    Parameters stays the single source of truth; this class only lets the
+    host see and automate it.
+*/
+class HostParameter : public juce::AudioProcessorParameterWithID
+{
+public:
+    HostParameter (const juce::ParameterID& parameterId,
+                   const juce::String& parameterName,
+                   std::atomic<float>& target,
+                   std::atomic<bool>& stateChangedFlag,
+                   float minValue,
+                   float maxValue,
+                   float defaultNativeValue,
+                   const juce::String& unitLabel = {});
+
+    //==============================================================================
+    float getValue() const override
+    {
+        return (value.load (std::memory_order_relaxed) - start) / length;
+    }
+
+    void setValue (float newValue) override
+    {
+        // Hosts send 0..1; the mapping cannot leave the native range.
+        const auto native = start + juce::jlimit (0.0f, 1.0f, newValue) * length;
+
+        if (value.exchange (native, std::memory_order_relaxed) != native)
+            stateChanged.store (true, std::memory_order_relaxed);
+    }
+
+    float getDefaultValue() const override;
+    juce::String getLabel() const override;
+    juce::String getText (float normalisedValue, int maximumStringLength) const override;
+    float getValueForText (const juce::String& text) const override;
+
+    //==============================================================================
+    float toNormalised (float native) const noexcept  { return (native - start) / length; }
+    float toNative (float normalised) const noexcept  { return start + normalised * length; }
+
+private:
+    std::atomic<float>& value;
+    std::atomic<bool>& stateChanged;
+    const float start;
+    const float length;
+    const float defaultValue;
+    const juce::String label;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HostParameter)
+};
@@ -1,4 +1,5 @@
 #include "Parameters.h"
+#include "HostParameter.h"
 
 //==============================================================================
 Parameters::Parameters()
@@ -6,27 +7,95 @@ Parameters::Parameters()
 {
 }
 
-float Parameters::getGain() const noexcept
+namespace
 {
-    return gain.load();
+    // In Index order. IDs double as state property names: never rename.
+    const Parameters::Spec specs[Parameters::numHostParameters] =
+    {
+        { "gain",          "Gain",             0.0f,  2.0f,   1.0f,  "" },
+        { "outputGain",    "Output",           0.0f,  2.0f,   1.0f,  "" },
+        { "duckThreshold", "Duck Threshold", -60.0f,  0.0f, -30.0f,  "dB" },
+        { "duckDepth",     "Duck Depth",       0.0f, 24.0f,   0.0f,  "dB" },
+        { "mix",           "Mix",              0.0f,  1.0f,   1.0f,  "" },
+    };
+}
+
+const Parameters::Spec& Parameters::getSpec (Index index) noexcept
+{
+    jassert (index >= 0 && index < numHostParameters);
+    return specs[index];
+}
+
+std::atomic<float>& Parameters::getAtomic (Index index) noexcept
+{
+    switch (index)
+    {
+        case gainIndex:             return gain;
+        case outputGainIndex:       return outputGain;
+        case duckThresholdIndex:    return duckThreshold;
+        case duckDepthIndex:        return duckDepth;
+        case mixIndex:              return mix;
+        case numHostParameters:     break;
+    }
+
+    jassertfalse;
+    return gain;
+}
+
+const std::atomic<float>& Parameters::getAtomic (Index index) const noexcept
+{
+    return const_cast<Parameters&> (*this).getAtomic (index);
+}
+
+float Parameters::getValue (Index index) const noexcept
+{
+    return getAtomic (index).load();
 }
 
-void Parameters::setGain (float newGain) noexcept
+void Parameters::setValue (Index index, float nativeValue) noexcept
 {
     // Canonical parameter boundary:
     // All incoming values (UI, hardware, automation, modulation)
     // are clamped here and nowhere else.
-    gain.store (juce::jlimit (0.0f, 2.0f, newGain));
+    const auto& spec = getSpec (index);
+    const auto clamped = juce::jlimit (spec.minValue, spec.maxValue, nativeValue);
+
+    const auto previous = getAtomic (index).exchange (clamped);
+    if (previous != clamped)
+    {
+        if (! journalSuspended)
+            undoJournal.record (index, previous, clamped);
+
+        markStateChanged();
+        notifyHost (index);
+    }
 }
 
-float Parameters::getOutputGain() const noexcept
+//==============================================================================
+float Parameters::getGain() const noexcept                      { return getValue (gainIndex); }
+void Parameters::setGain (float newGain) noexcept               { setValue (gainIndex, newGain); }
+
+float Parameters::getOutputGain() const noexcept                { return getValue (outputGainIndex); }
+void Parameters::setOutputGain (float newOutputGain) noexcept   { setValue (outputGainIndex, newOutputGain); }
+
+float Parameters::getDuckThreshold() const noexcept             { return getValue (duckThresholdIndex); }
+void Parameters::setDuckThreshold (float newThresholdDb) noexcept { setValue (duckThresholdIndex, newThresholdDb); }
+
+float Parameters::getDuckDepth() const noexcept                 { return getValue (duckDepthIndex); }
+void Parameters::setDuckDepth (float newDepthDb) noexcept       { setValue (duckDepthIndex, newDepthDb); }
+
+float Parameters::getMix() const noexcept                       { return getValue (mixIndex); }
+void Parameters::setMix (float newMix) noexcept                 { setValue (mixIndex, newMix); }
+
+bool Parameters::getLimiterEnabled() const noexcept
 {
-    return outputGain.load();
+    return limiterEnabled.load();
 }
 
-void Parameters::setOutputGain (float newOutputGain) noexcept
+void Parameters::setLimiterEnabled (bool shouldBeEnabled) noexcept
 {
-    outputGain.store (juce::jlimit (0.0f, 2.0f, newOutputGain));
+    if (limiterEnabled.exchange (shouldBeEnabled) != shouldBeEnabled)
+        markStateChanged();
 }
 
 int Parameters::getFocusedControlId() const noexcept
@@ -36,13 +105,153 @@ int Parameters::getFocusedControlId() const noexcept
 
 void Parameters::setFocusedControlId (int id) noexcept
 {
-    focusedControlId.store (id);
+    if (focusedControlId.exchange (id) != id)
+        markStateChanged();
+}
+
+void Parameters::setEditorSize (int w, int h) noexcept
+{
+    // clamp to reasonable limits (match your resize limits)
+    const auto clampedW = juce::jlimit (360, 900, w);
+    const auto clampedH = juce::jlimit (360, 900, h);
+
+    const bool widthChanged  = editorWidth.exchange (clampedW)  != clampedW;
+    const bool heightChanged = editorHeight.exchange (clampedH) != clampedH;
+
+    if (widthChanged || heightChanged)
+        markStateChanged();
+}
+
+//==============================================================================
+bool Parameters::consumeStateChange() noexcept
+{
+    return stateChanged.exchange (false);
+}
+
+//==============================================================================
+void Parameters::createHostParameters (juce::AudioProcessor& processor)
+{
+    jassert (hostParameters[gainIndex] == nullptr);
+
+    for (int i = 0; i < numHostParameters; ++i)
+    {
+        const auto index = static_cast<Index> (i);
+        const auto& spec = getSpec (index);
+        hostParameters[i] = new HostParameter ({ spec.id, 1 }, spec.name, getAtomic (index), stateChanged,
+                                               spec.minValue, spec.maxValue, spec.defaultValue, spec.label);
+    }
+
+    for (auto* p : hostParameters)
+        processor.addParameter (p);
+}
+
+void Parameters::beginChangeGesture (Index index)
+{
+    undoJournal.beginGesture (index);
+
+    if (auto* p = hostParameters[index])
+        p->beginChangeGesture();
+}
+
+void Parameters::endChangeGesture (Index index)
+{
+    undoJournal.endGesture (index);
+
+    if (auto* p = hostParameters[index])
+        p->endChangeGesture();
+}
+
+//==============================================================================
+int Parameters::undo()
+{
+    if (const auto* r = undoJournal.undo())
+    {
+        const juce::ScopedValueSetter<bool> suspend (journalSuspended, true);
+        setValue (static_cast<Index> (r->parameterIndex), r->oldValue);
+        return r->parameterIndex;
+    }
+
+    return -1;
+}
+
+int Parameters::redo()
+{
+    if (const auto* r = undoJournal.redo())
+    {
+        const juce::ScopedValueSetter<bool> suspend (journalSuspended, true);
+        setValue (static_cast<Index> (r->parameterIndex), r->newValue);
+        return r->parameterIndex;
+    }
+
+    return -1;
+}
+
+void Parameters::setNormalisedFromAudioThread (Index index, float normalised) noexcept
+{
+    if (auto* p = hostParameters[index])
+    {
+        const auto bit = 1u << index;
+
+        // First write since the last flush: keep the value it started from.
+        // Published by the fetch_or below, before the flush can see the bit.
+        if ((pendingHostNotifications.load (std::memory_order_relaxed) & bit) == 0)
+            audioWriteOrigins[(size_t) index].store (getValue (index), std::memory_order_relaxed);
+
+        p->setValue (normalised);
+        pendingHostNotifications.fetch_or (bit, std::memory_order_release);
+    }
+}
+
+juce::uint32 Parameters::flushHostNotifications()
+{
+    const auto pending = pendingHostNotifications.exchange (0, std::memory_order_acquire);
+
+    for (int i = 0; i < numHostParameters; ++i)
+    {
+        const auto index = static_cast<Index> (i);
+        const auto bit = 1u << i;
+
+        if ((pending & bit) != 0)
+        {
+            if ((audioGestures & bit) == 0)
+            {
+                audioGestures |= bit;
+                beginChangeGesture (index);
+            }
+
+            // Merges into the gesture's entry after the first flush
+            const auto origin = audioWriteOrigins[(size_t) i].load (std::memory_order_relaxed);
+            const auto current = getValue (index);
+
+            if (! journalSuspended && origin != current)
+                undoJournal.record (i, origin, current);
+
+            notifyHost (index);
+        }
+        else if ((audioGestures & bit) != 0)
+        {
+            audioGestures &= ~bit;
+            endChangeGesture (index);
+        }
+    }
+
+    return pending;
+}
+
+void Parameters::notifyHost (Index index)
+{
+    // Edits from UI/hardware land in the atomic first; the host only hears
+    // about them so it can record automation. Host writes never come here.
+    if (auto* p = hostParameters[index])
+        p->sendValueChangedMessageToListeners (p->getValue());
 }
 
 void Parameters::getState (juce::ValueTree& state) const
 {
-    state.setProperty ("gain", getGain(), nullptr);
-    state.setProperty ("outputGain", getOutputGain(), nullptr);
+    for (int i = 0; i < numHostParameters; ++i)
+        state.setProperty (specs[i].id, getValue (static_cast<Index> (i)), nullptr);
+
+    state.setProperty ("limiterEnabled", getLimiterEnabled(), nullptr);
     state.setProperty ("focusedControlId", getFocusedControlId(), nullptr);
 
         // ADD — Source/parameters/Parameters.cpp (inside Parameters::getState(ValueTree& state))
@@ -53,8 +262,14 @@ void Parameters::getState (juce::ValueTree& state) const
 
 void Parameters::setState (const juce::ValueTree& state)
 {
-    setGain (static_cast<float> (state.getProperty ("gain", 1.0)));
-    setOutputGain (static_cast<float> (state.getProperty ("outputGain", 1.0)));
+    // A recalled session is a new starting point, not an edit
+    const juce::ScopedValueSetter<bool> suspend (journalSuspended, true);
+    undoJournal.clear();
+
+    for (int i = 0; i < numHostParameters; ++i)
+        setValue (static_cast<Index> (i), static_cast<float> (state.getProperty (specs[i].id, specs[i].defaultValue)));
+
+    setLimiterEnabled (static_cast<bool> (state.getProperty ("limiterEnabled", false)));
     setFocusedControlId (static_cast<int> (state.getProperty ("focusedControlId", 1001)));
 
         // ADD — Source/parameters/Parameters.cpp (inside Parameters::setState(const ValueTree& state))
@@ -3,12 +3,23 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "UndoJournal.h"
+#include <array>
 #include <atomic>
 
+class HostParameter;
+
 //==============================================================================
 /**
     Simple parameter container without APVTS.
     Owns plugin parameters with thread-safe access.
+
+    Thread contract:
+    - Getters are lock-free and may be called from any thread (audio included).
+    - Setters, state and gesture calls belong to the message thread; they
+      notify the host, which is not guaranteed to be real-time safe.
+    - The host writes through HostParameter on whatever thread it likes;
+      that path is one atomic exchange (plus the state flag if it moved).
 */
 class Parameters
 {
@@ -16,6 +27,37 @@ public:
     Parameters();
     ~Parameters() = default;
 
+    // Host-visible parameters, in host order.
+    // Never reorder released entries: hosts store automation by index.
+    enum Index : int
+    {
+        gainIndex = 0,
+        outputGainIndex,
+        duckThresholdIndex,
+        duckDepthIndex,
+        mixIndex,
+        numHostParameters
+    };
+
+    static_assert (numHostParameters <= UndoJournal::kMaxParameters, "UndoJournal tracks gestures per parameter");
+
+    /** Static description of one host parameter; the single place ranges live. */
+    struct Spec
+    {
+        const char* id;             // host ID and state property name
+        const char* name;
+        float minValue;
+        float maxValue;
+        float defaultValue;
+        const char* label;
+    };
+
+    static const Spec& getSpec (Index index) noexcept;
+
+    /** Generic access by Index, in native units. setValue() clamps to the Spec. */
+    float getValue (Index index) const noexcept;
+    void setValue (Index index, float nativeValue) noexcept;
+
     //==============================================================================
     float getGain() const noexcept;
     void setGain (float newGain) noexcept;
@@ -23,9 +65,53 @@ public:
     float getOutputGain() const noexcept;
     void setOutputGain (float newOutputGain) noexcept;
 
+    /** Sidechain ducking: threshold in dB (-60..0), depth in dB (0..24, 0 = off). */
+    float getDuckThreshold() const noexcept;
+    void setDuckThreshold (float newThresholdDb) noexcept;
+
+    float getDuckDepth() const noexcept;
+    void setDuckDepth (float newDepthDb) noexcept;
+
+    /** Dry/wet balance, 0 = dry .. 1 = wet (default). */
+    float getMix() const noexcept;
+    void setMix (float newMix) noexcept;
+
+    bool getLimiterEnabled() const noexcept;
+    void setLimiterEnabled (bool shouldBeEnabled) noexcept;
+
     int getFocusedControlId() const noexcept;
     void setFocusedControlId (int id) noexcept;
 
+    //==============================================================================
+    /** Registers one HostParameter per Index with the processor.
+        Call once, from the processor constructor. The processor owns them. */
+    void createHostParameters (juce::AudioProcessor& processor);
+
+    /** Gesture brackets for edits that don't originate from the host
+        (slider drags, encoder bursts), so automation records one move. */
+    void beginChangeGesture (Index index);
+    void endChangeGesture (Index index);
+
+    /** Real-time safe write for audio-thread control sources (MIDI).
+        Lock-free, as a host write; the rest happens in flushHostNotifications(). */
+    void setNormalisedFromAudioThread (Index index, float normalised) noexcept;
+
+    /** Message thread, regularly: catches up on audio-thread writes. A run
+        of them counts as one gesture, for the host and the undo journal,
+        that ends on the first call that finds no new write. Returns a bit
+        per Index written since the previous call, for UI/LED feedback. */
+    juce::uint32 flushHostNotifications();
+
+    //==============================================================================
+    /** Message thread: steps through UI and hardware edits made via the
+        setters (host automation is the host's to undo). Gestures count as
+        one step. Return the Index that changed, or -1 if there was nothing
+        to undo/redo. */
+    int undo();
+    int redo();
+    bool canUndo() const noexcept  { return undoJournal.canUndo(); }
+    bool canRedo() const noexcept  { return undoJournal.canRedo(); }
+
     //==============================================================================
     void getState (juce::ValueTree& state) const;
     void setState (const juce::ValueTree& state);
@@ -34,22 +120,49 @@ public:
     int  getEditorWidth()  const noexcept { return editorWidth.load(); }
     int  getEditorHeight() const noexcept { return editorHeight.load(); }
 
-    void setEditorSize (int w, int h) noexcept
-    {
-        // clamp to reasonable limits (match your resize limits)
-        editorWidth.store  (juce::jlimit (360, 900, w));
-        editorHeight.store (juce::jlimit (360, 900, h));
-    }
+    void setEditorSize (int w, int h) noexcept;
+
+    //==============================================================================
+    /** True if anything persisted has changed since the last call.
+        Lets the processor reuse its last serialized state blob. */
+    bool consumeStateChange() noexcept;
 
 
 private:
+    std::atomic<float>& getAtomic (Index index) noexcept;
+    const std::atomic<float>& getAtomic (Index index) const noexcept;
+    void notifyHost (Index index);
+    void markStateChanged() noexcept { stateChanged.store (true, std::memory_order_relaxed); }
+
     std::atomic<float> gain;
     std::atomic<float> outputGain { 1.0f };
+    std::atomic<float> duckThreshold { -30.0f };
+    std::atomic<float> duckDepth { 0.0f };
+    std::atomic<float> mix { 1.0f };
+    std::atomic<bool> limiterEnabled { false };
     std::atomic<int> focusedControlId { 1001 };
     // ADD — Source/parameters/Parameters.h (inside class Parameters, private section)
     std::atomic<int> editorWidth  { 420 };
     std::atomic<int> editorHeight { 520 };
 
+    // Set by every setter and host write that changes a value
+    std::atomic<bool> stateChanged { true };
+
+    // Edits from the setters; bypassed while restoring state or undoing
+    UndoJournal undoJournal;
+    bool journalSuspended = false;
+
+    // Owned by the processor; null until createHostParameters() has run.
+    HostParameter* hostParameters[numHostParameters] {};
+
+    // Bit per Index written from the audio thread but not yet notified,
+    // and the value each had before the first of those writes
+    std::atomic<juce::uint32> pendingHostNotifications { 0 };
+    std::array<std::atomic<float>, numHostParameters> audioWriteOrigins {};
+
+    // Message thread: bit per Index with an audio-thread gesture open
+    juce::uint32 audioGestures = 0;
+
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Parameters)
 };
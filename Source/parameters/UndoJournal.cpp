@@ -0,0 +1,78 @@
+#include "UndoJournal.h"
+
+//==============================================================================
+void UndoJournal::record (int parameterIndex, float oldValue, float newValue) noexcept
+{
+    jassert (parameterIndex >= 0 && parameterIndex < kMaxParameters);
+    if (parameterIndex < 0 || parameterIndex >= kMaxParameters)
+        return;
+
+    const auto now = juce::Time::getMillisecondCounter();
+    const auto slot = (size_t) parameterIndex;
+
+    // Still inside the same gesture and its entry hasn't been undone or
+    // pushed out of the ring: extend it instead of adding a new one.
+    // Either way it's a new edit, so nothing past end can be redone.
+    if (gestureOpen[slot])
+    {
+        const auto entry = gestureEntry[slot];
+        if (entry >= begin && entry < end)
+        {
+            auto& r = at (entry);
+            r.newValue = newValue;
+            r.timeMs = now;
+            limit = end;
+            return;
+        }
+    }
+
+    at (end) = { parameterIndex, oldValue, newValue, now };
+
+    if (gestureOpen[slot])
+        gestureEntry[slot] = end;
+
+    limit = ++end;
+
+    if (end - begin > kCapacity)
+        ++begin;
+}
+
+void UndoJournal::beginGesture (int parameterIndex) noexcept
+{
+    if (parameterIndex < 0 || parameterIndex >= kMaxParameters)
+        return;
+
+    gestureOpen[(size_t) parameterIndex] = true;
+    gestureEntry[(size_t) parameterIndex] = -1;
+}
+
+void UndoJournal::endGesture (int parameterIndex) noexcept
+{
+    if (parameterIndex < 0 || parameterIndex >= kMaxParameters)
+        return;
+
+    gestureOpen[(size_t) parameterIndex] = false;
+}
+
+//==============================================================================
+const UndoJournal::Record* UndoJournal::undo() noexcept
+{
+    if (! canUndo())
+        return nullptr;
+
+    return &at (--end);
+}
+
+const UndoJournal::Record* UndoJournal::redo() noexcept
+{
+    if (! canRedo())
+        return nullptr;
+
+    return &at (end++);
+}
+
+void UndoJournal::clear() noexcept
+{
+    begin = end = limit = 0;
+    gestureEntry.fill (-1);
+}
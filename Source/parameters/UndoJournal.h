@@ -0,0 +1,68 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+
+//==============================================================================
+/**
+    Fixed-size undo/redo history of parameter edits.
+
+    Each edit is one 16-byte Record in a ring of kCapacity entries; once the
+    ring is full the oldest edit is forgotten, so memory never grows. Undo
+    and redo move a cursor and hand back one record: O(1), no allocation.
+
+    Edits made while a gesture is open for the same parameter (a slider
+    drag, an encoder burst) merge into the gesture's entry, so a whole move
+    undoes in one step.
+
+    Thread contract: message thread only, like the Parameters setters that
+    feed it.
+*/
+class UndoJournal
+{
+public:
+    struct Record
+    {
+        int parameterIndex;
+        float oldValue;
+        float newValue;
+        juce::uint32 timeMs;
+    };
+
+    static constexpr int kCapacity = 256;
+    static constexpr int kMaxParameters = 32;
+
+    UndoJournal() = default;
+
+    void record (int parameterIndex, float oldValue, float newValue) noexcept;
+
+    void beginGesture (int parameterIndex) noexcept;
+    void endGesture (int parameterIndex) noexcept;
+
+    bool canUndo() const noexcept  { return end > begin; }
+    bool canRedo() const noexcept  { return limit > end; }
+
+    /** The edit to revert (apply its oldValue), or nullptr. */
+    const Record* undo() noexcept;
+
+    /** The edit to re-apply (apply its newValue), or nullptr. */
+    const Record* redo() noexcept;
+
+    void clear() noexcept;
+
+private:
+    Record& at (juce::int64 sequence) noexcept  { return ring[(size_t) (sequence % kCapacity)]; }
+
+    std::array<Record, kCapacity> ring {};
+
+    // Monotonic sequence numbers: [begin, end) can be undone, [end, limit) redone
+    juce::int64 begin = 0;
+    juce::int64 end = 0;
+    juce::int64 limit = 0;
+
+    // Per parameter: open gesture and the entry it merges into (-1 = none yet)
+    std::array<bool, kMaxParameters> gestureOpen {};
+    std::array<juce::int64, kMaxParameters> gestureEntry {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UndoJournal)
+};
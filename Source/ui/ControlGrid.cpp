@@ -0,0 +1,210 @@
+#include "ControlGrid.h"
+
+//==============================================================================
+ControlGrid::Cell::Cell()
+{
+    label.setJustificationType (juce::Justification::centred);
+    label.setInterceptsMouseClicks (false, false);
+    addAndMakeVisible (label);
+
+    slider.setSliderStyle (juce::Slider::RotaryVerticalDrag);
+    slider.setTextBoxStyle (juce::Slider::TextBoxBelow, false, 80, 20);
+    // Wheel scrolls the grid, not the value
+    slider.setScrollWheelEnabled (false);
+    addAndMakeVisible (slider);
+}
+
+void ControlGrid::Cell::resized()
+{
+    auto r = getLocalBounds().reduced (4);
+    label.setBounds (r.removeFromTop (kLabelHeight));
+    slider.setBounds (r);
+}
+
+//==============================================================================
+ControlGrid::ControlGrid (Parameters& parametersToShow)
+    : parameters (parametersToShow),
+      cellBounds (static_cast<size_t> (kNumControls))
+{
+    startTimerHz (kRefreshHz);
+}
+
+ControlGrid::~ControlGrid()
+{
+    stopTimer();
+}
+
+void ControlGrid::paint (juce::Graphics& g)
+{
+    if (focusedIndex < 0)
+        return;
+
+    const auto bounds = getCellBoundsOnScreen (focusedIndex);
+    if (! bounds.intersects (getLocalBounds()))
+        return;
+
+    g.setColour (juce::Colours::white.withAlpha (0.25f));
+    g.drawRoundedRectangle (bounds.reduced (2).toFloat(), 12.0f, 2.0f);
+}
+
+void ControlGrid::resized()
+{
+    const int width = getWidth();
+    numColumns = juce::jmax (1, width / kCellWidth);
+
+    const int numRows = (kNumControls + numColumns - 1) / numColumns;
+    const int xOffset = juce::jmax (0, (width - numColumns * kCellWidth) / 2);
+    contentHeight = numRows * kCellHeight;
+
+    for (int i = 0; i < kNumControls; ++i)
+        cellBounds[(size_t) i] = { xOffset + (i % numColumns) * kCellWidth,
+                                   (i / numColumns) * kCellHeight,
+                                   kCellWidth, kCellHeight };
+
+    // Enough cells for every row that can be partly on screen; the pool
+    // only grows, and only here.
+    const int visibleRows = getHeight() / kCellHeight + 2;
+    const auto poolSize = static_cast<size_t> (juce::jmin (kNumControls, visibleRows * numColumns));
+
+    while (cellPool.size() < poolSize)
+    {
+        auto cell = std::make_unique<Cell>();
+        auto* c = cell.get();
+
+        c->slider.onValueChange = [this, c]
+        {
+            if (c->controlIndex >= 0 && onValueChange != nullptr)
+                onValueChange (c->controlIndex, static_cast<float> (c->slider.getValue()));
+        };
+        c->slider.onDragStart = [this, c]
+        {
+            if (c->controlIndex >= 0 && onDragStart != nullptr)
+                onDragStart (c->controlIndex);
+        };
+        c->slider.onDragEnd = [this, c]
+        {
+            if (c->controlIndex >= 0 && onDragEnd != nullptr)
+                onDragEnd (c->controlIndex);
+        };
+
+        addChildComponent (*c);
+        cellPool.push_back (std::move (cell));
+    }
+
+    setScroll (scrollY);
+}
+
+void ControlGrid::mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails& wheel)
+{
+    setScroll (scrollY - juce::roundToInt (wheel.deltaY * static_cast<float> (kCellHeight)));
+}
+
+//==============================================================================
+void ControlGrid::setFocusedIndex (int index)
+{
+    index = juce::jlimit (-1, kNumControls - 1, index);
+    if (index == focusedIndex)
+        return;
+
+    if (focusedIndex >= 0)
+        repaint (getCellBoundsOnScreen (focusedIndex));
+
+    focusedIndex = index;
+
+    if (focusedIndex < 0)
+        return;
+
+    // Scroll just enough to bring the focused cell into view
+    const auto& bounds = cellBounds[(size_t) focusedIndex];
+    if (bounds.getY() < scrollY)
+        setScroll (bounds.getY());
+    else if (bounds.getBottom() > scrollY + getHeight())
+        setScroll (bounds.getBottom() - getHeight());
+
+    repaint (getCellBoundsOnScreen (focusedIndex));
+}
+
+void ControlGrid::refreshControl (int index)
+{
+    if (auto* cell = findCell (index))
+        if (! cell->slider.isMouseButtonDown())
+            cell->slider.setValue (parameters.getValue (kControls[index].parameter), juce::dontSendNotification);
+}
+
+//==============================================================================
+void ControlGrid::timerCallback()
+{
+    for (int index = firstVisible; index < endVisible; ++index)
+        refreshControl (index);
+
+    if (onRefresh != nullptr)
+        onRefresh();
+}
+
+void ControlGrid::setScroll (int newScrollY)
+{
+    const int maxScroll = juce::jmax (0, contentHeight - getHeight());
+    const int clamped = juce::jlimit (0, maxScroll, newScrollY);
+
+    const bool changed = clamped != scrollY;
+    scrollY = clamped;
+    bindVisibleCells();
+
+    if (changed)
+        repaint();
+}
+
+void ControlGrid::bindVisibleCells()
+{
+    firstVisible = (scrollY / kCellHeight) * numColumns;
+    const int lastRow = (scrollY + juce::jmax (1, getHeight()) - 1) / kCellHeight;
+    endVisible = juce::jmin (kNumControls, (lastRow + 1) * numColumns,
+                             firstVisible + static_cast<int> (cellPool.size()));
+
+    for (size_t slot = 0; slot < cellPool.size(); ++slot)
+    {
+        auto& cell = *cellPool[slot];
+        const int index = firstVisible + static_cast<int> (slot);
+
+        if (index < endVisible)
+        {
+            if (cell.controlIndex != index)
+                bindCell (cell, index);
+
+            cell.setBounds (getCellBoundsOnScreen (index));
+            cell.setVisible (true);
+        }
+        else
+        {
+            cell.controlIndex = -1;
+            cell.setVisible (false);
+        }
+    }
+}
+
+void ControlGrid::bindCell (Cell& cell, int index)
+{
+    const auto& control = kControls[index];
+    const auto& spec = Parameters::getSpec (control.parameter);
+
+    cell.controlIndex = -1;     // no callbacks while re-ranging
+    cell.label.setText (spec.name, juce::dontSendNotification);
+    cell.slider.setRange (spec.minValue, spec.maxValue, control.interval);
+    cell.slider.setTextValueSuffix (juce::String (spec.label).isEmpty() ? juce::String() : " " + juce::String (spec.label));
+    cell.slider.setValue (parameters.getValue (control.parameter), juce::dontSendNotification);
+    cell.controlIndex = index;
+}
+
+ControlGrid::Cell* ControlGrid::findCell (int index) const noexcept
+{
+    // Cells are bound in order starting at firstVisible
+    if (index < firstVisible || index >= endVisible)
+        return nullptr;
+
+    return cellPool[(size_t) (index - firstVisible)].get();
+}
+
+juce::Rectangle<int> ControlGrid::getCellBoundsOnScreen (int index) const noexcept
+{
+    return cellBounds[(size_t) index].translated (0, -scrollY);
+}
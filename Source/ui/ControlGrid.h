@@ -0,0 +1,86 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "ControlIds.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+    Scrolling grid of rotary controls generated from kControls.
+
+    - Layout is computed once per resize into a flat array of cell rectangles
+      (content coordinates); paint and hit-testing only index into it.
+    - Controls are virtualized: a small pool of slider cells, sized to what
+      fits on screen, is re-bound to whichever controls are currently
+      visible. Scrolling re-binds cells; nothing is created per control.
+    - Focus is a table index, so moving it and drawing its ring are O(1).
+    - Visible cells follow Parameters on a timer, so host automation and
+      MIDI writes (which bypass the bindings) show up in the UI.
+*/
+class ControlGrid : public juce::Component,
+                    private juce::Timer
+{
+public:
+    explicit ControlGrid (Parameters& parametersToShow);
+    ~ControlGrid() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+    void mouseWheelMove (const juce::MouseEvent&, const juce::MouseWheelDetails&) override;
+
+    /** Table index of the focused control, or -1. Scrolls it into view. */
+    void setFocusedIndex (int index);
+    int getFocusedIndex() const noexcept  { return focusedIndex; }
+
+    /** Pushes the current parameter value to the control's cell, if visible. */
+    void refreshControl (int index);
+
+    /** Called when the user edits or grabs a control (table index, native value). */
+    std::function<void (int, float)> onValueChange;
+    std::function<void (int)> onDragStart;
+    std::function<void (int)> onDragEnd;
+
+    /** Called after each timer refresh, so controls outside the grid can
+        follow Parameters (state restore, undo) at the same moment. */
+    std::function<void()> onRefresh;
+
+    static constexpr int kCellWidth   = 120;
+    static constexpr int kCellHeight  = 140;
+    static constexpr int kLabelHeight = 20;
+    static constexpr int kRefreshHz   = 15;
+
+private:
+    struct Cell : public juce::Component
+    {
+        Cell();
+        void resized() override;
+
+        juce::Label label;
+        juce::Slider slider;
+        int controlIndex = -1;
+    };
+
+    void timerCallback() override;
+    void setScroll (int newScrollY);
+    void bindVisibleCells();
+    void bindCell (Cell& cell, int index);
+    Cell* findCell (int index) const noexcept;
+    juce::Rectangle<int> getCellBoundsOnScreen (int index) const noexcept;
+
+    Parameters& parameters;
+
+    std::vector<juce::Rectangle<int>> cellBounds;   // one per kControls entry
+    std::vector<std::unique_ptr<Cell>> cellPool;
+    int numColumns = 1;
+    int contentHeight = 0;
+    int scrollY = 0;
+    int focusedIndex = -1;
+
+    // Controls [firstVisible, endVisible) are bound to cellPool[0...]
+    int firstVisible = 0;
+    int endVisible = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ControlGrid)
+};
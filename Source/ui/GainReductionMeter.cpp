@@ -0,0 +1,46 @@
+#include "GainReductionMeter.h"
+
+//==============================================================================
+GainReductionMeter::GainReductionMeter (SidechainDucker& duckerToShow)
+    : ducker (duckerToShow)
+{
+    setOpaque (true);
+    setInterceptsMouseClicks (false, false);
+
+    startTimerHz (kMaxFps);
+}
+
+GainReductionMeter::~GainReductionMeter()
+{
+    stopTimer();
+}
+
+void GainReductionMeter::paint (juce::Graphics& g)
+{
+    auto bounds = getLocalBounds().toFloat();
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId).darker (0.3f));
+
+    // Reduction grows from the right edge, like a console GR meter
+    const auto fraction = juce::jlimit (0.0f, 1.0f, displayedDb / kRangeDb);
+    g.setColour (juce::Colours::orange.withAlpha (0.8f));
+    g.fillRect (bounds.removeFromRight (bounds.getWidth() * fraction));
+
+    g.setColour (juce::Colours::white.withAlpha (0.7f));
+    g.setFont (12.0f);
+    g.drawText ("GR " + juce::String (-displayedDb, 1) + " dB", getLocalBounds().reduced (4, 0),
+                juce::Justification::centredLeft, false);
+}
+
+void GainReductionMeter::timerCallback()
+{
+    const auto peakDb = ducker.consumePeakReductionDb();
+    const auto fallen = juce::jmax (0.0f, displayedDb - kFallDbPerSecond / static_cast<float> (kMaxFps));
+    const auto next = juce::jmax (peakDb, fallen);
+
+    // Tenth-of-a-dB steps: that's all the text shows
+    if (std::abs (next - displayedDb) >= 0.05f || (next == 0.0f && displayedDb != 0.0f))
+    {
+        displayedDb = next;
+        repaint();
+    }
+}
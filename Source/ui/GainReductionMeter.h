@@ -0,0 +1,34 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "dsp/SidechainDucker.h"
+
+//==============================================================================
+/**
+    Horizontal gain-reduction bar for the SidechainDucker.
+
+    Polls the ducker's lock-free peak-hold at kMaxFps, lets the display fall
+    back at kFallDbPerSecond, and repaints only this (opaque) component and
+    only when the drawn value moved.
+*/
+class GainReductionMeter : public juce::Component,
+                           private juce::Timer
+{
+public:
+    explicit GainReductionMeter (SidechainDucker& duckerToShow);
+    ~GainReductionMeter() override;
+
+    void paint (juce::Graphics&) override;
+
+    static constexpr int kMaxFps = 30;
+    static constexpr float kRangeDb = 24.0f;
+    static constexpr float kFallDbPerSecond = 20.0f;
+
+private:
+    void timerCallback() override;
+
+    SidechainDucker& ducker;
+    float displayedDb = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GainReductionMeter)
+};
@@ -1,231 +1,135 @@
 #include "MainView.h"
-
-static constexpr ui_core::ControlId kGainControlId = 1001;
-static constexpr ui_core::ControlId kOutputControlId = 1002;
+#include "ControlIds.h"
 
 //==============================================================================
 MainView::MainView (PluginTemplateAudioProcessor& p)
-    : audioProcessor (p)
+    : audioProcessor (p),
+      controlSurface (p.getControlSurface()),
+      controlGrid (p.getParameters()),
+      gainReductionMeter (p.getSidechainDucker()),
+      spectrumView (p.getSpectrumAnalyzer())
 {
+    addAndMakeVisible (spectrumView);
+    addAndMakeVisible (controlGrid);
+    addAndMakeVisible (gainReductionMeter);
+
     setWantsKeyboardFocus (true);
 
-    // Gain Label
-    gainLabel.setText ("Gain", juce::dontSendNotification);
-    gainLabel.attachToComponent (&gainSlider, false);
-    gainLabel.setJustificationType (juce::Justification::centred);
-    addAndMakeVisible (gainLabel);
-
-    // Gain Slider
-    gainSlider.setSliderStyle (juce::Slider::RotaryVerticalDrag);
-    gainSlider.setTextBoxStyle (juce::Slider::TextBoxBelow, false, 80, 20);
-    gainSlider.setRange (0.0, 2.0, 0.01);
-    gainSlider.setValue (audioProcessor.getParameters().getGain());
-    gainSlider.onValueChange = [this] { gainSliderChanged(); };
-    gainSlider.onDragStart = [this]
+    // Grid edits go through the same path as hardware edits
+    controlGrid.onValueChange = [this] (int index, float native) { controlSurface.setControlValue (index, native); };
+    controlGrid.onDragStart = [this] (int index)
     {
-        const auto prev = focusManager.getFocusedControl();
-        focusManager.setFocusedControl (kGainControlId);
-        audioProcessor.getParameters().setFocusedControlId (static_cast<int> (kGainControlId));
-        if (hardwareOutput)
-        {
-            if (prev && *prev != kGainControlId)
-                hardwareOutput->setFocus (*prev, false);
-            hardwareOutput->setFocus (kGainControlId, true);
-        }
+        controlSurface.beginGesture (index);
+        controlSurface.focusControl (index);
     };
-    addAndMakeVisible (gainSlider);
-
-    // Output Label
-    outputLabel.setText ("Output", juce::dontSendNotification);
-    outputLabel.attachToComponent (&outputSlider, false);
-    outputLabel.setJustificationType (juce::Justification::centred);
-    addAndMakeVisible (outputLabel);
-
-    // Output Slider
-    outputSlider.setSliderStyle (juce::Slider::RotaryVerticalDrag);
-    outputSlider.setTextBoxStyle (juce::Slider::TextBoxBelow, false, 80, 20);
-    outputSlider.setRange (0.0, 2.0, 0.01);
-    outputSlider.setValue (audioProcessor.getParameters().getOutputGain());
-    outputSlider.onValueChange = [this] { outputSliderChanged(); };
-    outputSlider.onDragStart = [this]
+    controlGrid.onDragEnd = [this] (int index) { controlSurface.endGesture (index); };
+
+    // Output limiter switch: follows Parameters with the grid cells, so
+    // setStateInformation shows up here too
+    auto syncLimiterButton = [this]
     {
-        const auto prev = focusManager.getFocusedControl();
-        focusManager.setFocusedControl (kOutputControlId);
-        audioProcessor.getParameters().setFocusedControlId (static_cast<int> (kOutputControlId));
-        if (hardwareOutput)
-        {
-            if (prev && *prev != kOutputControlId)
-                hardwareOutput->setFocus (*prev, false);
-            hardwareOutput->setFocus (kOutputControlId, true);
-        }
+        limiterButton.setToggleState (audioProcessor.getParameters().getLimiterEnabled(), juce::dontSendNotification);
     };
-    addAndMakeVisible (outputSlider);
-
-    // Setup focus adapters
-    gainFocusAdapter.controlId = kGainControlId;
-    gainFocusAdapter.focusedControlIdPtr = &focusedControlId;
-    gainFocusAdapter.repaintTarget = this;
-    focusManager.registerWidget (kGainControlId, &gainFocusAdapter);
-
-    outputFocusAdapter.controlId = kOutputControlId;
-    outputFocusAdapter.focusedControlIdPtr = &focusedControlId;
-    outputFocusAdapter.repaintTarget = this;
-    focusManager.registerWidget (kOutputControlId, &outputFocusAdapter);
-
-    // Add binding to registry (mapped: native 0..2, normalized 0..1)
-    bindingRegistry.add (ui_core::makeMappedBinding (
-        kGainControlId,
-        [this]() { return audioProcessor.getParameters().getGain(); },
-        [this](float native)
-        {
-            audioProcessor.getParameters().setGain (native);
-            // keep UI in sync without recursion
-            gainSlider.setValue (native, juce::dontSendNotification);
-            // Send LED feedback (convert native to normalized)
-            if (hardwareOutput)
-                hardwareOutput->setLEDValue (kGainControlId, native / 2.0f);
-        },
-        [](float normalized) { return normalized * 2.0f; },      // toNative: 0..1 -> 0..2
-        [](float native) { return native / 2.0f; }));            // toNormalized: 0..2 -> 0..1
-
-    bindingRegistry.add (ui_core::makeMappedBinding (
-        kOutputControlId,
-        [this]() { return audioProcessor.getParameters().getOutputGain(); },
-        [this](float native)
-        {
-            audioProcessor.getParameters().setOutputGain (native);
-            // keep UI in sync without recursion
-            outputSlider.setValue (native, juce::dontSendNotification);
-            // Send LED feedback (convert native to normalized)
-            if (hardwareOutput)
-                hardwareOutput->setLEDValue (kOutputControlId, native / 2.0f);
-        },
-        [](float normalized) { return normalized * 2.0f; },      // toNative: 0..1 -> 0..2
-        [](float native) { return native / 2.0f; }));            // toNormalized: 0..2 -> 0..1
-
-    // Create hardware adapter
-    hardwareAdapter = std::make_unique<PluginHardwareAdapter> (bindingRegistry);
-    
-    // Create hardware output adapter
-    hardwareOutput = std::make_unique<PluginHardwareOutputAdapter>();
+    syncLimiterButton();
+    controlGrid.onRefresh = syncLimiterButton;
+    limiterButton.onClick = [this] { audioProcessor.getParameters().setLimiterEnabled (limiterButton.getToggleState()); };
+    addAndMakeVisible (limiterButton);
 
-    // Restore persisted focus
-    int persistedId = audioProcessor.getParameters().getFocusedControlId();
-    ui_core::ControlId focusIdToRestore = kGainControlId; // default fallback
-    
-    // Validate: check if binding exists for persisted ID
-    if (bindingRegistry.find (static_cast<ui_core::ControlId> (persistedId)) != nullptr)
-        focusIdToRestore = static_cast<ui_core::ControlId> (persistedId);
-    
-    focusManager.setFocusedControl (focusIdToRestore);
-    if (hardwareOutput)
-    {
-        // Clear other controls
-        if (focusIdToRestore != kGainControlId)
-            hardwareOutput->setFocus (kGainControlId, false);
-        if (focusIdToRestore != kOutputControlId)
-            hardwareOutput->setFocus (kOutputControlId, false);
-        // Set focused control
-        hardwareOutput->setFocus (focusIdToRestore, true);
-    }
+    // Attach: pick up current focus, nothing is re-sent to hardware
+    controlGrid.setFocusedIndex (controlSurface.getFocusedIndex());
+    controlSurface.addListener (this);
 
     setSize (400, 500);
 }
 
 MainView::~MainView()
 {
-    focusManager.unregisterWidget (kGainControlId, &gainFocusAdapter);
-    focusManager.unregisterWidget (kOutputControlId, &outputFocusAdapter);
+    controlSurface.removeListener (this);
 }
 
 void MainView::paint (juce::Graphics& g)
 {
     g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    if (focusedControlId == kGainControlId)
-    {
-        auto focusBounds = gainSlider.getBounds().expanded (4);
-        g.setColour (juce::Colours::white.withAlpha (0.25f));
-        g.drawRoundedRectangle (focusBounds.toFloat(), 12.0f, 2.0f);
-    }
-    else if (focusedControlId == kOutputControlId)
-    {
-        auto focusBounds = outputSlider.getBounds().expanded (4);
-        g.setColour (juce::Colours::white.withAlpha (0.25f));
-        g.drawRoundedRectangle (focusBounds.toFloat(), 12.0f, 2.0f);
-    }
 }
 
-// REPLACE — MainView::resized() (Source/ui/MainView.cpp)
 void MainView::resized()
 {
     auto area = getLocalBounds().reduced (20);
 
-    const int rowHeight   = area.getHeight() / 2;   // two equal rows
-    const int labelHeight = 22;
-    const int gap         = 8;
-
-    auto topRow    = area.removeFromTop (rowHeight);
-    auto bottomRow = area;
+    spectrumView.setBounds (area.removeFromTop (100));
+    area.removeFromTop (8);
 
-    // --- Gain row
+    // --- Bottom row: limiter | GR meter
     {
-        auto r = topRow;
-        auto labelArea = r.removeFromTop (labelHeight);
-        gainLabel.setBounds (labelArea);
-
-        r.removeFromTop (gap);
-
-        const int sliderSize = juce::jmin (r.getWidth(), r.getHeight());
-        gainSlider.setBounds (r.withSizeKeepingCentre (sliderSize, sliderSize));
+        auto r = area.removeFromBottom (24);
+        limiterButton.setBounds (r.removeFromLeft (100));
+        gainReductionMeter.setBounds (r.reduced (2, 0));
     }
+    area.removeFromBottom (8);
 
-    // --- Output row
-    {
-        auto r = bottomRow;
-        auto labelArea = r.removeFromTop (labelHeight);
-        outputLabel.setBounds (labelArea);
-
-        r.removeFromTop (gap);
-
-        const int sliderSize = juce::jmin (r.getWidth(), r.getHeight());
-        outputSlider.setBounds (r.withSizeKeepingCentre (sliderSize, sliderSize));
-    }
+    controlGrid.setBounds (area);
 }
 
-
-void MainView::gainSliderChanged()
+//==============================================================================
+void MainView::controlFocusChanged (int index)
 {
-    audioProcessor.getParameters().setGain (static_cast<float> (gainSlider.getValue()));
+    controlGrid.setFocusedIndex (index);
 }
 
-void MainView::outputSliderChanged()
+void MainView::controlValueChanged (int index)
 {
-    audioProcessor.getParameters().setOutputGain (static_cast<float> (outputSlider.getValue()));
+    // keep UI in sync without recursion
+    controlGrid.refreshControl (index);
 }
 
 bool MainView::keyPressed (const juce::KeyPress& key)
 {
-    if (key == juce::KeyPress::tabKey)
+    if (key.getKeyCode() == juce::KeyPress::tabKey)
     {
-        // Tab cycles focus between controls
-        const auto prev = focusManager.getFocusedControl();
-        ui_core::ControlId newFocusId;
-        if (focusedControlId == kGainControlId)
-            newFocusId = kOutputControlId;
-        else
-            newFocusId = kGainControlId;
-        
-        focusManager.setFocusedControl (newFocusId);
-        audioProcessor.getParameters().setFocusedControlId (static_cast<int> (newFocusId));
-        
-        // Send hardware focus feedback
-        if (hardwareOutput)
+        // Tab / Shift-Tab step through kControls order
+        const auto step = key.getModifiers().isShiftDown() ? kNumControls - 1 : 1;
+        const auto current = juce::jmax (0, controlSurface.getFocusedIndex());
+        controlSurface.focusControl ((current + step) % kNumControls);
+        return true;
+    }
+
+    // Cmd/Ctrl-Z undoes a parameter edit, with Shift it redoes
+    if (key.getKeyCode() == 'Z' || key.getKeyCode() == 'z')
+    {
+        if (key.getModifiers().isCommandDown())
         {
-            if (prev && *prev != newFocusId)
-                hardwareOutput->setFocus (*prev, false);
-            hardwareOutput->setFocus (newFocusId, true);
+            if (key.getModifiers().isShiftDown())
+                controlSurface.redo();
+            else
+                controlSurface.undo();
+            return true;
         }
+    }
+
+    const auto focusedControlId = controlSurface.getFocusedControlId();
+
+    // L arms MIDI learn for the focused control (press again to cancel)
+    if (key.getTextCharacter() == 'l' || key.getTextCharacter() == 'L')
+    {
+        auto& decoder = audioProcessor.getMidiControlDecoder();
+        if (decoder.getLearnTarget() != 0)
+            decoder.cancelLearn();
+        else
+            decoder.startLearn (focusedControlId != 0 ? focusedControlId : kGainControlId);
+        return true;
+    }
+
+    // R toggles hardware event capture (see HardwareEventRecorder)
+    if (key.getTextCharacter() == 'r' || key.getTextCharacter() == 'R')
+    {
+        controlSurface.toggleEventRecording();
+        return true;
+    }
+
+    // P replays the last capture at its original timing (press again to stop)
+    if (key.getTextCharacter() == 'p' || key.getTextCharacter() == 'P')
+    {
+        controlSurface.toggleEventPlayback();
         return true;
     }
 
@@ -236,19 +140,19 @@ bool MainView::keyPressed (const juce::KeyPress& key)
     if (ch == 'h' || ch == 'H')
     {
         ui_core::HardwareControlEvent e { targetId, 0.375f, false };
-        hardwareAdapter->processEvent (e);
+        controlSurface.getInputAdapter().processEvent (e);
         return true;
     }
     if (ch == 'j' || ch == 'J')
     {
         ui_core::HardwareControlEvent e { targetId, 0.025f, true };
-        hardwareAdapter->processEvent (e);
+        controlSurface.getInputAdapter().processEvent (e);
         return true;
     }
     if (ch == 'k' || ch == 'K')
     {
         ui_core::HardwareControlEvent e { targetId, -0.025f, true };
-        hardwareAdapter->processEvent (e);
+        controlSurface.getInputAdapter().processEvent (e);
         return true;
     }
     return false;
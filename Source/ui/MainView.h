@@ -2,17 +2,21 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "../PluginProcessor.h"
-#include <ui_core/UiCore.h>
-#include "hardware/PluginHardwareAdapter.h"
-#include "hardware/PluginHardwareOutputAdapter.h"
-#include <memory>
+#include "ControlGrid.h"
+#include "GainReductionMeter.h"
+#include "SpectrumView.h"
 
 //==============================================================================
 /**
     Main UI view component.
-    Contains the plugin's user interface elements.
+
+    A lightweight observer of the processor's ControlSurface: bindings,
+    focus and hardware I/O live there and survive the editor. Controls are
+    generated from kControls (ControlIds.h); nothing here is written per
+    parameter.
 */
-class MainView : public juce::Component
+class MainView : public juce::Component,
+                 private ControlSurface::Listener
 {
 public:
     explicit MainView (PluginTemplateAudioProcessor& p);
@@ -23,46 +27,16 @@ public:
     bool keyPressed (const juce::KeyPress& key) override;
 
 private:
-    PluginTemplateAudioProcessor& audioProcessor;
-
-    juce::Label gainLabel;
-    juce::Slider gainSlider;
-    juce::Label outputLabel;
-    juce::Slider outputSlider;
-
-    ui_core::FocusManager focusManager;
-    ui_core::BindingRegistry bindingRegistry;
-    std::unique_ptr<PluginHardwareAdapter> hardwareAdapter;
-    std::unique_ptr<PluginHardwareOutputAdapter> hardwareOutput;
+    void controlFocusChanged (int index) override;
+    void controlValueChanged (int index) override;
 
-    // Focus state: tracks which control is focused (0 = none)
-    ui_core::ControlId focusedControlId = 0;
-
-    // Adapter object that FocusManager can call
-    struct FocusFlagAdapter : ui_core::Focusable
-    {
-        ui_core::ControlId controlId = 0;
-        ui_core::ControlId* focusedControlIdPtr = nullptr;
-        juce::Component* repaintTarget = nullptr;
-        void setFocused (bool focused) override
-        {
-            if (focusedControlIdPtr)
-            {
-                if (focused)
-                    *focusedControlIdPtr = controlId;
-                else if (*focusedControlIdPtr == controlId)
-                    *focusedControlIdPtr = 0;
-            }
-            if (repaintTarget)
-                repaintTarget->repaint();
-        }
-    };
-
-    FocusFlagAdapter gainFocusAdapter;
-    FocusFlagAdapter outputFocusAdapter;
+    PluginTemplateAudioProcessor& audioProcessor;
+    ControlSurface& controlSurface;
 
-    void gainSliderChanged();
-    void outputSliderChanged();
+    ControlGrid controlGrid;
+    juce::ToggleButton limiterButton { "Limiter" };
+    GainReductionMeter gainReductionMeter;
+    SpectrumView spectrumView;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MainView)
 };
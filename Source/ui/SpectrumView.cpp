@@ -0,0 +1,75 @@
+#include "SpectrumView.h"
+
+//==============================================================================
+SpectrumView::SpectrumView (SpectrumAnalyzer& analyzerToShow)
+    : analyzer (analyzerToShow)
+{
+    // Opaque, so a repaint here never repaints the sliders behind it
+    setOpaque (true);
+    setInterceptsMouseClicks (false, false);
+
+    analyzer.setActive (true);
+    startTimerHz (kMaxFps);
+}
+
+SpectrumView::~SpectrumView()
+{
+    stopTimer();
+    analyzer.setActive (false);
+}
+
+void SpectrumView::paint (juce::Graphics& g)
+{
+    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId).darker (0.3f));
+
+    g.setColour (juce::Colours::white.withAlpha (0.7f));
+    g.strokePath (spectrumPath, juce::PathStrokeType (1.5f));
+
+    g.setColour (juce::Colours::white.withAlpha (0.4f));
+    g.setFont (11.0f);
+    g.drawText (costText, getLocalBounds().reduced (4, 2), juce::Justification::topRight, false);
+}
+
+void SpectrumView::resized()
+{
+    rebuildPath();
+}
+
+void SpectrumView::timerCallback()
+{
+    const bool levelsChanged = analyzer.process();
+    if (levelsChanged)
+        rebuildPath();
+
+    // Cost readout: once a second is plenty
+    const bool costChanged = ++ticksSinceCostUpdate >= kMaxFps;
+    if (costChanged)
+    {
+        ticksSinceCostUpdate = 0;
+        costText = "FFT " + juce::String (analyzer.getAverageProcessMs(), 3) + " ms";
+    }
+
+    if (levelsChanged || costChanged)
+        repaint();
+}
+
+void SpectrumView::rebuildPath()
+{
+    const auto bounds = getLocalBounds().toFloat().reduced (2.0f);
+    const auto& levels = analyzer.getLevels();
+    const auto xStep = bounds.getWidth() / static_cast<float> (SpectrumAnalyzer::kNumPoints - 1);
+
+    spectrumPath.clear();
+    spectrumPath.preallocateSpace (3 * SpectrumAnalyzer::kNumPoints);
+
+    for (int i = 0; i < SpectrumAnalyzer::kNumPoints; ++i)
+    {
+        const auto x = bounds.getX() + xStep * static_cast<float> (i);
+        const auto y = bounds.getBottom() - levels[(size_t) i] * bounds.getHeight();
+
+        if (i == 0)
+            spectrumPath.startNewSubPath (x, y);
+        else
+            spectrumPath.lineTo (x, y);
+    }
+}
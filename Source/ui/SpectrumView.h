@@ -0,0 +1,38 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "dsp/SpectrumAnalyzer.h"
+
+//==============================================================================
+/**
+    Draws the SpectrumAnalyzer output.
+
+    Owns the analyzer's consumer side: a timer capped at kMaxFps runs the
+    FFT work and repaints only this (opaque) component when levels changed.
+    The analyzer is active only while a view exists. The corner shows the
+    analyzer's mean cost per timer tick, i.e. what the view costs the
+    message thread.
+*/
+class SpectrumView : public juce::Component,
+                     private juce::Timer
+{
+public:
+    explicit SpectrumView (SpectrumAnalyzer& analyzerToShow);
+    ~SpectrumView() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+    static constexpr int kMaxFps = 30;
+
+private:
+    void timerCallback() override;
+    void rebuildPath();
+
+    SpectrumAnalyzer& analyzer;
+    juce::Path spectrumPath;
+    juce::String costText;
+    int ticksSinceCostUpdate = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SpectrumView)
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <vector>
+
+//==============================================================================
+/**
+    Timing helpers for tests in the "Benchmarks" category.
+
+    Benchmarks log their numbers instead of asserting on them: timings vary
+    by machine, so a regression shows up as a change in the log, not a red
+    ctest. Run them from a Release build.
+*/
+namespace benchmark
+{
+    inline constexpr const char* kCategory = "Benchmarks";
+
+    /** Wall time per call, in microseconds. */
+    struct Stats
+    {
+        double median = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    /** Times `runs` calls of fn, after `warmUp` untimed ones. */
+    template <typename Fn>
+    Stats measure (int runs, Fn&& fn, int warmUp = 8)
+    {
+        for (int i = 0; i < warmUp; ++i)
+            fn();
+
+        std::vector<double> times;
+        times.reserve (static_cast<size_t> (runs));
+
+        for (int i = 0; i < runs; ++i)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            fn();
+            const auto ticks = juce::Time::getHighResolutionTicks() - start;
+            times.push_back (juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6);
+        }
+
+        std::sort (times.begin(), times.end());
+        return { times[times.size() / 2],
+                 times[static_cast<size_t> (static_cast<double> (times.size() - 1) * 0.99)],
+                 times.back() };
+    }
+
+    /** Fixed-width number for log tables. */
+    inline juce::String format (double value, int width = 9, int decimals = 2)
+    {
+        return juce::String (value, decimals).paddedLeft (' ', width);
+    }
+}
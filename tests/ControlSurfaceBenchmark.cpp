@@ -0,0 +1,85 @@
+#include "ParameterHost.h"
+#include "Benchmark.h"
+#include "hardware/ControlSurface.h"
+
+namespace
+{
+    /** Counts what would go out to the hardware. */
+    struct CountingOutput : ui_core::HardwareOutputAdapter
+    {
+        void setLEDValue (ui_core::ControlId, float) override            { ++numSends; }
+        void setFocus (ui_core::ControlId, bool) override                { ++numSends; }
+        void setDisplayText (ui_core::ControlId, int, const char*) override  { ++numSends; }
+
+        int numSends = 0;
+    };
+
+    struct NullListener : ControlSurface::Listener
+    {
+        void controlFocusChanged (int) override  {}
+        void controlValueChanged (int) override  {}
+    };
+}
+
+//==============================================================================
+/**
+    Editor open/close as far as ControlSurface sees it: MainView reads the
+    focus and attaches as a listener, then detaches. The baseline is the
+    same work with a ControlSurface built per editor, which is what opening
+    an editor cost before the surface moved to processor scope: bindings
+    rebuilt, focus, LEDs and displays re-sent.
+
+    The component tree itself isn't built; PluginTests has no GUI module.
+*/
+class ControlSurfaceBenchmark : public juce::UnitTest
+{
+public:
+    ControlSurfaceBenchmark() : juce::UnitTest ("ControlSurface", benchmark::kCategory) {}
+
+    void runTest() override
+    {
+        beginTest ("Editor open/close");
+
+        Parameters parameters;
+        ParameterHost host (parameters);
+        CountingOutput output;
+        NullListener view;
+
+        ControlSurface surface (parameters, &output);
+        output.numSends = 0;
+
+        const auto attach = benchmark::measure (1000, [&]
+        {
+            const auto focused = surface.getFocusedIndex();
+            juce::ignoreUnused (focused);
+            surface.addListener (&view);
+            surface.removeListener (&view);
+        });
+        const auto attachSends = output.numSends;
+
+        output.numSends = 0;
+        {
+            ControlSurface editorSurface (parameters, &output);
+        }
+        const auto perEditorSends = output.numSends;
+
+        const auto perEditor = benchmark::measure (200, [&]
+        {
+            ControlSurface editorSurface (parameters, &output);
+            editorSurface.addListener (&view);
+            editorSurface.removeListener (&view);
+        });
+
+        logMessage ("                        median us   p99 us   max us   hw sends/open");
+        logMessage ("  attach to surface    " + row (attach) + juce::String (attachSends).paddedLeft (' ', 16));
+        logMessage ("  surface per editor   " + row (perEditor) + juce::String (perEditorSends).paddedLeft (' ', 16));
+    }
+
+private:
+    static juce::String row (const benchmark::Stats& stats)
+    {
+        return benchmark::format (stats.median, 10) + benchmark::format (stats.p99) + benchmark::format (stats.max);
+    }
+};
+
+static ControlSurfaceBenchmark controlSurfaceBenchmark;
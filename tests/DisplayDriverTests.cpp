@@ -0,0 +1,130 @@
+#include "hardware/ControlSurface.h"
+#include "hardware/VirtualDisplayDevice.h"
+#include <cstring>
+
+//==============================================================================
+/**
+    Drives ui_core::DisplayDriver into a VirtualDisplayDevice and checks what
+    the screens received: text, send counts, diffing and the rate cap at the
+    interval ControlSurface uses.
+*/
+class DisplayDriverTests : public juce::UnitTest
+{
+public:
+    DisplayDriverTests() : juce::UnitTest ("DisplayDriver", "Hardware") {}
+
+    void runTest() override
+    {
+        constexpr std::uint32_t interval = 40;
+
+        beginTest ("First flush sends every line; unchanged text is not resent");
+        {
+            VirtualDisplayDevice device (4);
+            ui_core::DisplayDriver driver (device, interval);
+            driver.addDisplay (1);
+            driver.addDisplay (2);
+
+            expect (driver.setText (1, ui_core::kDisplayNameLine, "Gain"));
+            expect (driver.setText (1, ui_core::kDisplayValueLine, "0.0 dB"));
+            expect (driver.setText (2, ui_core::kDisplayNameLine, "Mix"));
+            expect (! driver.setText (3, ui_core::kDisplayNameLine, "unknown display"));
+            expect (! driver.setText (1, ui_core::kDisplayLines, "unknown line"));
+
+            driver.flush (1000);
+            expectEquals (device.getNumSends(), 4, "empty value line of display 2 included");
+            expectEquals (juce::String (device.getText (1, ui_core::kDisplayNameLine)), juce::String ("Gain"));
+            expectEquals (juce::String (device.getText (1, ui_core::kDisplayValueLine)), juce::String ("0.0 dB"));
+            expectEquals (juce::String (device.getText (2, ui_core::kDisplayNameLine)), juce::String ("Mix"));
+            expectEquals (juce::String (device.getText (2, ui_core::kDisplayValueLine)), juce::String());
+            expect (device.getText (3, ui_core::kDisplayNameLine) == nullptr);
+
+            // Same text again, and a shorter text over a longer one and back
+            driver.setText (1, ui_core::kDisplayNameLine, "Gain");
+            driver.setText (1, ui_core::kDisplayValueLine, "0");
+            driver.setText (1, ui_core::kDisplayValueLine, "0.0 dB");
+            driver.flush (2000);
+            expectEquals (device.getNumSends(), 4);
+
+            driver.setText (1, ui_core::kDisplayValueLine, "-3.0 dB");
+            driver.flush (3000);
+            expectEquals (device.getNumSends(), 5, "only the changed line");
+            expectEquals (juce::String (device.getText (1, ui_core::kDisplayValueLine)), juce::String ("-3.0 dB"));
+
+            driver.invalidate();
+            driver.flush (4000);
+            expectEquals (device.getNumSends(), 9, "everything again after invalidate()");
+        }
+
+        beginTest ("At most one send per display per interval");
+        {
+            VirtualDisplayDevice device (4);
+            ui_core::DisplayDriver driver (device, interval);
+            driver.addDisplay (1);
+            driver.flush (0);
+            const auto sent = device.getNumSends();
+
+            driver.setText (1, ui_core::kDisplayValueLine, "1");
+            driver.flush (interval - 1);
+            expectEquals (device.getNumSends(), sent, "held back");
+            expectEquals (juce::String (device.getText (1, ui_core::kDisplayValueLine)), juce::String());
+
+            driver.setText (1, ui_core::kDisplayValueLine, "2");
+            driver.flush (interval);
+            expectEquals (device.getNumSends(), sent + 1, "latest text once the interval is over");
+            expectEquals (juce::String (device.getText (1, ui_core::kDisplayValueLine)), juce::String ("2"));
+        }
+
+        beginTest ("Text is truncated to fit");
+        {
+            VirtualDisplayDevice device (1);
+            ui_core::DisplayDriver driver (device, interval);
+            driver.addDisplay (1);
+
+            const juce::String longText = juce::String::repeatedString ("0123456789", 5);
+            driver.setText (1, ui_core::kDisplayNameLine, longText.toRawUTF8());
+            driver.flush (0);
+
+            const auto* shown = device.getText (1, ui_core::kDisplayNameLine);
+            expectEquals ((int) std::strlen (shown), ui_core::kDisplayTextCapacity - 1);
+            expect (longText.startsWith (shown));
+        }
+
+        beginTest ("Surplus displays are ignored, like on a real device");
+        {
+            VirtualDisplayDevice device (1);
+            ui_core::DisplayDriver driver (device, interval);
+            driver.addDisplay (1);
+            driver.addDisplay (2);
+            driver.flush (0);
+
+            expect (device.getText (1, ui_core::kDisplayNameLine) != nullptr);
+            expect (device.getText (2, ui_core::kDisplayNameLine) == nullptr);
+            expectEquals (device.getNumSends(), ui_core::kDisplayLines);
+        }
+
+        beginTest ("ControlSurface's timer rate survives a jittery timer");
+        {
+            VirtualDisplayDevice device (1);
+            ui_core::DisplayDriver driver (device, ControlSurface::kDisplayMinIntervalMs);
+            driver.addDisplay (1);
+            driver.flush (0);
+            const auto sent = device.getNumSends();
+
+            // Timer ticks alternating early and late by 5 ms, new text on each
+            constexpr std::uint32_t period = 1000 / ControlSurface::kDisplayRefreshHz;
+            constexpr int numTicks = 100;
+            std::uint32_t now = 0;
+
+            for (int tick = 0; tick < numTicks; ++tick)
+            {
+                now += tick % 2 == 0 ? period - 5 : period + 5;
+                driver.setText (1, ui_core::kDisplayValueLine, juce::String (tick).toRawUTF8());
+                driver.flush (now);
+            }
+
+            expectEquals (device.getNumSends() - sent, numTicks, "one value send per tick");
+        }
+    }
+};
+
+static DisplayDriverTests displayDriverTests;
@@ -0,0 +1,74 @@
+#include "dsp/DryWetMixer.h"
+#include <vector>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+}
+
+//==============================================================================
+/**
+    Runs a silent wet path, so once the mix has settled the output is the
+    dry input delayed by the latency and scaled by (1 - mix): anything left
+    fully wet comes out silent, anything misaligned comes out wrong.
+*/
+class DryWetMixerTests : public juce::UnitTest
+{
+public:
+    DryWetMixerTests() : juce::UnitTest ("DryWetMixer", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest ("Host blocks up to the prepared size");
+        expect (runDelayed (64, 64));
+
+        beginTest ("Host blocks larger than the prepared size are chunked, not left wet");
+        expect (runDelayed (64, 300));
+    }
+
+private:
+    bool runDelayed (int preparedBlockSize, int maxHostBlock)
+    {
+        constexpr int latency = 100;
+        constexpr int total = 12000;
+        constexpr float targetMix = 0.25f;
+        const int settled = static_cast<int> (DryWetMixer::kSmoothingSeconds * kSampleRate) + maxHostBlock;
+
+        DryWetMixer mixer;
+        mixer.prepare (kSampleRate, preparedBlockSize, 2, latency);
+
+        auto random = getRandom();
+        std::vector<float> input (static_cast<size_t> (total)), output (static_cast<size_t> (total));
+
+        for (auto& sample : input)
+            sample = random.nextFloat() * 2.0f - 1.0f;
+
+        auto delayed = [&] (int i) { return i < latency ? 0.0f : input[(size_t) (i - latency)]; };
+
+        for (int pos = 0; pos < total;)
+        {
+            const int count = juce::jmin (total - pos, 1 + random.nextInt (maxHostBlock));
+            juce::AudioBuffer<float> host (2, count);
+            host.copyFrom (0, 0, input.data() + pos, count);
+            host.copyFrom (1, 0, input.data() + pos, count);
+
+            mixer.process (host, 2, targetMix, [&] (juce::AudioBuffer<float>& wet)
+            {
+                expect (wet.getNumSamples() <= preparedBlockSize, "chunk larger than prepared");
+                wet.clear();
+            });
+
+            std::copy (host.getReadPointer (1), host.getReadPointer (1) + count, output.begin() + pos);
+            pos += count;
+        }
+
+        // Ramps in from fully wet first
+        for (int i = settled; i < total; ++i)
+            if (std::abs (output[(size_t) i] - (1.0f - targetMix) * delayed (i)) > 1.0e-6f)
+                return false;
+
+        return true;
+    }
+};
+
+static DryWetMixerTests dryWetMixerTests;
@@ -0,0 +1,156 @@
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "dsp/FixedBlockAdapter.h"
+#include "dsp/LookAheadLimiter.h"
+#include "Benchmark.h"
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+}
+
+//==============================================================================
+class FixedBlockAdapterTests : public juce::UnitTest
+{
+public:
+    FixedBlockAdapterTests() : juce::UnitTest ("FixedBlockAdapter", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest ("Fixed blocks in, a pure delay of getLatencySamples() out");
+        {
+            FixedBlockAdapter adapter;
+            adapter.prepare (2, 100);
+            expectEquals (adapter.getBlockSize(), 112, "rounded up to a multiple of 16");
+            expectEquals (adapter.getLatencySamples(), adapter.getBlockSize());
+
+            auto random = getRandom();
+            const int total = 5000;
+            std::vector<float> input (static_cast<size_t> (total)), output (static_cast<size_t> (total));
+
+            for (auto& sample : input)
+                sample = random.nextFloat();
+
+            bool alwaysFull = true;
+            for (int pos = 0; pos < total;)
+            {
+                // Irregular host blocks, down to one sample
+                const int count = juce::jmin (total - pos, 1 + random.nextInt (70));
+                juce::AudioBuffer<float> host (2, count);
+
+                for (int ch = 0; ch < 2; ++ch)
+                    host.copyFrom (ch, 0, input.data() + pos, count);
+
+                adapter.process (host, [&] (juce::AudioBuffer<float>& block)
+                {
+                    alwaysFull = alwaysFull && block.getNumSamples() == adapter.getBlockSize();
+                });
+
+                std::copy (host.getReadPointer (1), host.getReadPointer (1) + count, output.begin() + pos);
+                pos += count;
+            }
+
+            expect (alwaysFull, "the callback only ever sees full blocks");
+
+            const int latency = adapter.getLatencySamples();
+            bool delayed = true;
+            for (int i = 0; i < total; ++i)
+                delayed = delayed && output[(size_t) i] == (i < latency ? 0.0f : input[(size_t) (i - latency)]);
+
+            expect (delayed);
+        }
+    }
+};
+
+static FixedBlockAdapterTests fixedBlockAdapterTests;
+
+//==============================================================================
+/**
+    Cost of tiny host blocks with and without the fixed internal block size
+    (PLUGIN_INTERNAL_BLOCK_SIZE), running the output limiter as the DSP core.
+
+    ns/sample is the mean over one second of audio. The per-callback p99 and
+    max show the jitter price: with re-blocking, the one host callback that
+    completes an internal block pays for all of it.
+*/
+class FixedBlockAdapterBenchmark : public juce::UnitTest
+{
+public:
+    FixedBlockAdapterBenchmark() : juce::UnitTest ("FixedBlockAdapter", benchmark::kCategory) {}
+
+    void runTest() override
+    {
+        beginTest ("Host block 1-64 samples: direct vs fixed 64 / 256");
+
+        logMessage ("       |           direct          |          fixed 64         |         fixed 256");
+        logMessage ("  host |  ns/smp  p99 us   max us  |  ns/smp  p99 us   max us  |  ns/smp  p99 us   max us");
+
+        for (const int hostBlock : { 1, 2, 4, 8, 16, 32, 64 })
+        {
+            juce::String line = juce::String (hostBlock).paddedLeft (' ', 6) + " |";
+
+            for (const int internalBlock : { 0, 64, 256 })
+            {
+                const auto result = run (hostBlock, internalBlock);
+                line << benchmark::format (result.nsPerSample, 8) << benchmark::format (result.perCallback.p99, 8)
+                     << benchmark::format (result.perCallback.max, 9) << "  |";
+            }
+
+            logMessage (line);
+        }
+    }
+
+private:
+    struct Result
+    {
+        double nsPerSample = 0.0;
+        benchmark::Stats perCallback;
+    };
+
+    static Result run (int hostBlock, int internalBlock)
+    {
+        constexpr int numSamples = 48000;
+
+        FixedBlockAdapter adapter;
+        LookAheadLimiter limiter;
+
+        if (internalBlock > 0)
+        {
+            adapter.prepare (2, internalBlock);
+            limiter.prepare (kSampleRate, adapter.getBlockSize(), 2);
+        }
+        else
+        {
+            limiter.prepare (kSampleRate, hostBlock, 2);
+        }
+
+        juce::AudioBuffer<float> host (2, hostBlock);
+        int phase = 0;
+
+        auto callback = [&]
+        {
+            // Loud enough that the limiter works on every block
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < hostBlock; ++i)
+                    host.setSample (ch, i, (phase + i) % 48 < 24 ? 1.5f : -1.5f);
+
+            phase += hostBlock;
+
+            if (internalBlock > 0)
+                adapter.process (host, [&] (juce::AudioBuffer<float>& block) { limiter.process (block, 2, true); });
+            else
+                limiter.process (host, 2, true);
+        };
+
+        Result result;
+        result.nsPerSample = benchmark::measure (10, [&]
+        {
+            for (int done = 0; done < numSamples; done += hostBlock)
+                callback();
+        }, 2).median * 1000.0 / numSamples;
+
+        result.perCallback = benchmark::measure (numSamples / hostBlock, callback, 64);
+        return result;
+    }
+};
+
+static FixedBlockAdapterBenchmark fixedBlockAdapterBenchmark;
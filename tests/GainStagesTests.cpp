@@ -0,0 +1,258 @@
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "dsp/GainStages.h"
+#include "Benchmark.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kNumChannels = 2;
+
+    using GainChain = FusedStages<GainRampStage, GainCurveStage>;
+
+    void fillNoise (juce::AudioBuffer<float>& buffer, juce::Random& random)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+    }
+
+    /** A ducking-like curve: dips and recovers, never above one. */
+    std::vector<float> makeCurve (int numSamples)
+    {
+        std::vector<float> curve (static_cast<size_t> (numSamples));
+        for (int i = 0; i < numSamples; ++i)
+            curve[(size_t) i] = 0.6f + 0.4f * std::cos (static_cast<float> (i) * 0.01f);
+        return curve;
+    }
+
+    //==============================================================================
+    /**
+        The gain stages as one pass per stage, written out as plain loops:
+        what processCore ran before the stages were fused. The ramp follows
+        its definition (linear from the previous target to the new one over
+        rampLength samples) rather than GainRampStage's incremental state.
+    */
+    struct SeparatePasses
+    {
+        void prepare (double sampleRate)
+        {
+            rampLength = juce::jmax (1, juce::roundToInt (sampleRate * GainRampStage::kRampMs / 1000.0));
+        }
+
+        void setTarget (float newTarget)
+        {
+            if (newTarget == target)
+                return;
+
+            from = gainAt (elapsed);
+            target = newTarget;
+            elapsed = 0;
+        }
+
+        void process (juce::AudioBuffer<float>& buffer, int start, int numSamples, const float* curve)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                auto* data = buffer.getWritePointer (ch, start);
+
+                for (int i = 0; i < numSamples; ++i)
+                    data[i] *= gainAt (elapsed + i + 1);
+
+                if (curve != nullptr)
+                    juce::FloatVectorOperations::multiply (data, curve, numSamples);
+            }
+
+            elapsed += numSamples;
+        }
+
+        float gainAt (int n) const
+        {
+            return n >= rampLength ? target
+                                   : from + (target - from) * static_cast<float> (n) / static_cast<float> (rampLength);
+        }
+
+        int rampLength = 1;
+        int elapsed = 0;
+        float from = 1.0f;
+        float target = 1.0f;
+    };
+}
+
+//==============================================================================
+class GainStagesTests : public juce::UnitTest
+{
+public:
+    GainStagesTests() : juce::UnitTest ("GainStages", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest ("Fused ramp x curve matches the per-stage loops");
+        {
+            GainChain fused;
+            fused.get<GainRampStage>().prepare (kSampleRate);
+            SeparatePasses separate;
+            separate.prepare (kSampleRate);
+
+            auto random = getRandom();
+            double worst = 0.0;
+
+            for (int block = 0; block < 200; ++block)
+            {
+                const int numSamples = 1 + random.nextInt (512);
+                const auto curve = makeCurve (numSamples);
+
+                // New targets now and then, some mid-ramp
+                if (random.nextInt (8) == 0)
+                {
+                    const auto target = random.nextFloat() * 2.0f;
+                    fused.get<GainRampStage>().setTarget (target);
+                    separate.setTarget (target);
+                }
+
+                juce::AudioBuffer<float> input (kNumChannels, numSamples);
+                fillNoise (input, random);
+                juce::AudioBuffer<float> expected (input), actual (input);
+
+                // Ducking: fused ramp x curve. Otherwise: the ramp alone.
+                const bool ducking = block % 3 != 0;
+                separate.process (expected, 0, numSamples, ducking ? curve.data() : nullptr);
+
+                if (ducking)
+                {
+                    fused.get<GainCurveStage>().setCurve (curve.data());
+                    fused.process (actual, kNumChannels, 0, numSamples);
+                }
+                else
+                {
+                    fused.processOnly<GainRampStage> (actual, kNumChannels, 0, numSamples);
+                }
+
+                for (int ch = 0; ch < kNumChannels; ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                        worst = juce::jmax (worst, (double) std::abs (actual.getSample (ch, i) - expected.getSample (ch, i)));
+            }
+
+            expectLessThan (worst, 1.0e-5, "largest difference");
+        }
+
+        beginTest ("Settled at unity, the ramp alone leaves the signal untouched");
+        {
+            GainChain fused;
+            fused.get<GainRampStage>().prepare (kSampleRate);
+            expect (fused.get<GainRampStage>().isUnity());
+
+            auto random = getRandom();
+            juce::AudioBuffer<float> buffer (kNumChannels, 256);
+            fillNoise (buffer, random);
+            const juce::AudioBuffer<float> original (buffer);
+
+            fused.processOnly<GainRampStage> (buffer, kNumChannels, 0, 256);
+
+            bool same = true;
+            for (int ch = 0; ch < kNumChannels; ++ch)
+                for (int i = 0; i < 256; ++i)
+                    same = same && buffer.getSample (ch, i) == original.getSample (ch, i);
+
+            expect (same);
+        }
+    }
+};
+
+static GainStagesTests gainStagesTests;
+
+//==============================================================================
+/**
+    ns per sample of the gain stages, stereo, at several block sizes:
+
+    - ramp x curve, one pass per stage (the same stages, one FusedStages each)
+      against the fused pass;
+    - with ducking off, the ramp times an all-ones curve (what processCore
+      did before) against the ramp alone.
+*/
+class GainStagesBenchmark : public juce::UnitTest
+{
+public:
+    GainStagesBenchmark() : juce::UnitTest ("GainStages", benchmark::kCategory) {}
+
+    void runTest() override
+    {
+        beginTest ("Fused vs separate passes, ns/sample");
+
+        logMessage ("         |   ramp x curve    |   ducking off");
+        logMessage ("   block |  separate   fused |  x unity  ramp only");
+
+        for (const int blockSize : { 32, 128, 512, 2048, 8192 })
+        {
+            const auto curve = makeCurve (blockSize);
+            const std::vector<float> unity (static_cast<size_t> (blockSize), 1.0f);
+
+            FusedStages<GainRampStage> rampPass;
+            FusedStages<GainCurveStage> curvePass;
+            GainChain fused;
+
+            rampPass.get<GainRampStage>().prepare (kSampleRate);
+            fused.get<GainRampStage>().prepare (kSampleRate);
+
+            const auto separate = nsPerSample (blockSize, rampPass, [&] (juce::AudioBuffer<float>& buffer)
+            {
+                curvePass.get<GainCurveStage>().setCurve (curve.data());
+                rampPass.process (buffer, kNumChannels, 0, blockSize);
+                curvePass.process (buffer, kNumChannels, 0, blockSize);
+            });
+
+            const auto together = nsPerSample (blockSize, fused, [&] (juce::AudioBuffer<float>& buffer)
+            {
+                fused.get<GainCurveStage>().setCurve (curve.data());
+                fused.process (buffer, kNumChannels, 0, blockSize);
+            });
+
+            const auto timesUnity = nsPerSample (blockSize, fused, [&] (juce::AudioBuffer<float>& buffer)
+            {
+                fused.get<GainCurveStage>().setCurve (unity.data());
+                fused.process (buffer, kNumChannels, 0, blockSize);
+            });
+
+            const auto rampOnly = nsPerSample (blockSize, fused, [&] (juce::AudioBuffer<float>& buffer)
+            {
+                fused.processOnly<GainRampStage> (buffer, kNumChannels, 0, blockSize);
+            });
+
+            logMessage (juce::String (blockSize).paddedLeft (' ', 8) + " |"
+                        + benchmark::format (separate) + benchmark::format (together, 8) + " |"
+                        + benchmark::format (timesUnity) + benchmark::format (rampOnly, 11));
+        }
+    }
+
+private:
+    /** Keeps the ramp moving (a target change every block) so its per-sample
+        work is always done, and starts every block from the same noise so
+        repeated curves never drive it into denormals. */
+    template <typename Chain, typename Fn>
+    static double nsPerSample (int blockSize, Chain& chainWithRamp, Fn&& processBlock)
+    {
+        constexpr int samplesPerRun = 1 << 18;
+
+        juce::AudioBuffer<float> source (kNumChannels, blockSize), buffer (kNumChannels, blockSize);
+        juce::Random random (1);
+        fillNoise (source, random);
+
+        auto& ramp = chainWithRamp.template get<GainRampStage>();
+        int n = 0;
+
+        return benchmark::measure (20, [&]
+        {
+            for (int done = 0; done < samplesPerRun; done += blockSize)
+            {
+                for (int ch = 0; ch < kNumChannels; ++ch)
+                    buffer.copyFrom (ch, 0, source, ch, 0, blockSize);
+
+                ramp.setTarget ((++n & 1) != 0 ? 0.9f : 1.1f);
+                processBlock (buffer);
+            }
+        }, 2).median * 1000.0 / samplesPerRun;
+    }
+};
+
+static GainStagesBenchmark gainStagesBenchmark;
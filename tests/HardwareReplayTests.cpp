@@ -0,0 +1,130 @@
+#include "ParameterHost.h"
+#include "SilentOutput.h"
+#include "ControlIds.h"
+#include "hardware/ControlSurface.h"
+#include "hardware/HardwareEventPlayer.h"
+
+namespace
+{
+    juce::File createCaptureFile()
+    {
+        return juce::File::getSpecialLocation (juce::File::tempDirectory)
+                   .getNonexistentChildFile ("HardwareReplayTest", ".hwev");
+    }
+}
+
+//==============================================================================
+/**
+    Records hardware input through one ControlSurface, replays the capture
+    with HardwareEventPlayer into a fresh one and checks both end up with the
+    same parameters: the capture format, the player and the binding path
+    round-trip a session exactly.
+*/
+class HardwareReplayTests : public juce::UnitTest
+{
+public:
+    HardwareReplayTests() : juce::UnitTest ("HardwareEventPlayer", "Hardware") {}
+
+    void runTest() override
+    {
+        const auto file = createCaptureFile();
+        SilentOutput output;
+
+        Parameters recorded;
+        ParameterHost recordedHost (recorded);
+        int numSent = 0;
+
+        beginTest ("Capture through the live input path");
+        {
+            ControlSurface surface (recorded, &output);
+            expect (surface.startEventRecording (file));
+
+            auto random = getRandom();
+            auto& input = surface.getInputAdapter();
+
+            for (; numSent < 500; ++numSent)
+            {
+                const auto& control = kControls[random.nextInt (kNumControls)];
+                const bool relative = random.nextBool();
+                const auto value = relative ? (random.nextFloat() - 0.5f) * 0.1f : random.nextFloat();
+                input.processEvent ({ control.id, value, relative });
+            }
+
+            // Not bound: recorded and replayed, changes nothing
+            input.processEvent ({ 9999, 0.5f, false });
+            ++numSent;
+
+            surface.stopEventRecording();
+            expect (! surface.isRecordingEvents());
+        }
+
+        beginTest ("Replay into a fresh surface reproduces the parameters");
+        {
+            HardwareEventPlayer player (file);
+            expect (player.isValid());
+            expectEquals (player.getNumEvents(), numSent);
+
+            juce::uint64 previous = 0, timestamp = 0;
+            bool ordered = true;
+            for (int i = 0; i < player.getNumEvents(); ++i)
+            {
+                player.getEvent (i, timestamp);
+                ordered = ordered && timestamp >= previous;
+                previous = timestamp;
+            }
+            expect (ordered, "timestamps never go backwards");
+
+            Parameters replayed;
+            ParameterHost replayedHost (replayed);
+            ControlSurface surface (replayed, &output);
+
+            expectEquals (player.replayAll (surface.getInputAdapter()), numSent);
+
+            int moved = 0;
+            for (int i = 0; i < Parameters::numHostParameters; ++i)
+            {
+                const auto index = static_cast<Parameters::Index> (i);
+                expectWithinAbsoluteError (replayed.getValue (index), recorded.getValue (index), 1.0e-6f,
+                                           Parameters::getSpec (index).id);
+
+                if (recorded.getValue (index) != Parameters::getSpec (index).defaultValue)
+                    ++moved;
+            }
+
+            expectGreaterThan (moved, 0, "the capture changed something");
+        }
+
+        beginTest ("A capture cut short loses only its partial last record");
+        {
+            const auto fullSize = file.getSize();
+            {
+                juce::FileOutputStream stream (file);
+                stream.write ("\x01\x02\x03\x04\x05", 5);
+            }
+
+            HardwareEventPlayer player (file);
+            expectEquals (player.getNumEvents(), numSent);
+            expectEquals (file.getSize(), fullSize + 5);
+        }
+
+        beginTest ("Anything else is rejected");
+        {
+            HardwareEventPlayer missing (juce::File {});
+            expect (! missing.isValid());
+
+            file.deleteFile();
+            {
+                juce::FileOutputStream stream (file);
+                stream << "not a hardware event capture";
+            }
+
+            HardwareEventPlayer notACapture (file);
+            expect (! notACapture.isValid());
+            expectEquals (notACapture.getNumEvents(), 0);
+        }
+
+        file.deleteFile();
+    }
+};
+
+static HardwareReplayTests hardwareReplayTests;
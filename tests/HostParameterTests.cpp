@@ -0,0 +1,147 @@
+#include "ParameterHost.h"
+#include "parameters/HostParameter.h"
+
+//==============================================================================
+/**
+    HostParameter as the host sees it, on top of the Parameters atomics it
+    exposes: Spec metadata, the 0..1 mapping, reads and writes through the
+    shared atomic, text conversion and the state-changed flag.
+*/
+class HostParameterTests : public juce::UnitTest
+{
+public:
+    HostParameterTests() : juce::UnitTest ("HostParameter", "Parameters") {}
+
+    void runTest() override
+    {
+        beginTest ("IDs, names and defaults come from the Spec");
+        {
+            Parameters parameters;
+            ParameterHost host (parameters);
+
+            forEachParameter (host, [&] (Parameters::Index index, HostParameter& p)
+            {
+                const auto& spec = Parameters::getSpec (index);
+                expectEquals (p.getParameterID(), juce::String (spec.id));
+                expectEquals (p.getName (64), juce::String (spec.name));
+                expectEquals (p.getLabel(), juce::String (spec.label));
+
+                expectWithinAbsoluteError (p.toNative (p.getDefaultValue()), spec.defaultValue, 1.0e-5f, spec.id);
+                expectEquals (p.getValue(), p.getDefaultValue(), "a fresh Parameters starts at the default");
+            });
+        }
+
+        beginTest ("Normalisation is linear over the native range");
+        {
+            Parameters parameters;
+            ParameterHost host (parameters);
+
+            forEachParameter (host, [&] (Parameters::Index index, HostParameter& p)
+            {
+                const auto& spec = Parameters::getSpec (index);
+                expectEquals (p.toNormalised (spec.minValue), 0.0f, spec.id);
+                expectEquals (p.toNormalised (spec.maxValue), 1.0f, spec.id);
+                expectEquals (p.toNative (0.0f), spec.minValue, spec.id);
+                expectEquals (p.toNative (1.0f), spec.maxValue, spec.id);
+
+                const auto tolerance = 1.0e-6f * (spec.maxValue - spec.minValue);
+                for (const auto n : { 0.1f, 0.25f, 0.5f, 0.9f })
+                {
+                    expectWithinAbsoluteError (p.toNative (n), spec.minValue + n * (spec.maxValue - spec.minValue), tolerance, spec.id);
+                    expectWithinAbsoluteError (p.toNormalised (p.toNative (n)), n, 1.0e-6f, spec.id);
+                }
+            });
+        }
+
+        beginTest ("setValue and getValue go through the Parameters atomic");
+        {
+            Parameters parameters;
+            ParameterHost host (parameters);
+
+            forEachParameter (host, [&] (Parameters::Index index, HostParameter& p)
+            {
+                const auto& spec = Parameters::getSpec (index);
+                const auto tolerance = 1.0e-6f * (spec.maxValue - spec.minValue);
+
+                // Host writes show up in what the audio thread reads...
+                p.setValue (0.75f);
+                expectWithinAbsoluteError (parameters.getValue (index), p.toNative (0.75f), tolerance, spec.id);
+                expectWithinAbsoluteError (p.getValue(), 0.75f, 1.0e-6f, spec.id);
+
+                // ...and writes from the plugin side show up for the host
+                const auto native = spec.minValue + 0.2f * (spec.maxValue - spec.minValue);
+                parameters.setValue (index, native);
+                expectWithinAbsoluteError (p.getValue(), 0.2f, 1.0e-6f, spec.id);
+
+                // Out-of-range host values land on the ends of the range
+                p.setValue (-0.5f);
+                expectEquals (parameters.getValue (index), spec.minValue, spec.id);
+                p.setValue (1.5f);
+                expectEquals (parameters.getValue (index), spec.maxValue, spec.id);
+            });
+        }
+
+        beginTest ("Text round-trips to the value it was made from");
+        {
+            Parameters parameters;
+            ParameterHost host (parameters);
+
+            forEachParameter (host, [&] (Parameters::Index index, HostParameter& p)
+            {
+                const auto& spec = Parameters::getSpec (index);
+
+                // getText() shows two decimals in native units
+                const auto tolerance = 0.005f / (spec.maxValue - spec.minValue);
+                for (const auto n : { 0.0f, 0.3f, 0.5f, 1.0f })
+                    expectWithinAbsoluteError (p.getValueForText (p.getText (n, 32)), n, tolerance, spec.id);
+
+                expectEquals (p.getValueForText (juce::String (spec.maxValue + 100.0f)), 1.0f, spec.id);
+                expectEquals (p.getValueForText (juce::String (spec.minValue - 100.0f)), 0.0f, spec.id);
+            });
+        }
+
+        beginTest ("The saved state is rebuilt only after a real change");
+        {
+            Parameters parameters;
+            ParameterHost host (parameters);
+            auto* mix = host.getParameters()[Parameters::mixIndex];
+
+            // What getStateInformation() asks before reusing its blob
+            expect (parameters.consumeStateChange(), "nothing cached yet");
+            expect (! parameters.consumeStateChange());
+
+            // Automation resending the current value, block after block
+            for (int i = 0; i < 16; ++i)
+                mix->setValue (mix->getValue());
+
+            expect (! parameters.consumeStateChange(), "cached state reused");
+
+            mix->setValue (0.25f);
+            expect (parameters.consumeStateChange(), "rebuilt after a host write");
+            expect (! parameters.consumeStateChange());
+
+            parameters.setNormalisedFromAudioThread (Parameters::mixIndex, 0.25f);
+            expect (! parameters.consumeStateChange(), "same value from MIDI");
+            parameters.setNormalisedFromAudioThread (Parameters::mixIndex, 0.5f);
+            expect (parameters.consumeStateChange(), "new value from MIDI");
+        }
+    }
+
+private:
+    template <typename Fn>
+    void forEachParameter (ParameterHost& host, Fn&& fn)
+    {
+        const auto& hostParameters = host.getParameters();
+        expectEquals (hostParameters.size(), (int) Parameters::numHostParameters);
+
+        for (int i = 0; i < hostParameters.size(); ++i)
+        {
+            auto* p = dynamic_cast<HostParameter*> (hostParameters[i]);
+            expect (p != nullptr);
+            if (p != nullptr)
+                fn (static_cast<Parameters::Index> (i), *p);
+        }
+    }
+};
+
+static HostParameterTests hostParameterTests;
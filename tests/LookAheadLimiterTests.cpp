@@ -0,0 +1,242 @@
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "dsp/LookAheadLimiter.h"
+#include "Benchmark.h"
+#include <cmath>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+
+    void fillSine (juce::AudioBuffer<float>& buffer, double frequency, double phase, float amplitude)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                data[i] = amplitude * static_cast<float> (std::sin (juce::MathConstants<double>::twoPi * frequency * i / kSampleRate + phase));
+        }
+    }
+
+    /** Amplitude of a steady sine from its RMS: the peak between samples too. */
+    float sineAmplitude (const float* data, int numSamples)
+    {
+        double sum = 0.0;
+        for (int i = 0; i < numSamples; ++i)
+            sum += static_cast<double> (data[i]) * data[i];
+
+        return static_cast<float> (std::sqrt (2.0 * sum / numSamples));
+    }
+
+    float maxAbs (const float* data, int numSamples)
+    {
+        float m = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            m = juce::jmax (m, std::abs (data[i]));
+
+        return m;
+    }
+}
+
+//==============================================================================
+class LookAheadLimiterTests : public juce::UnitTest
+{
+public:
+    LookAheadLimiterTests() : juce::UnitTest ("LookAheadLimiter", "DSP") {}
+
+    void runTest() override
+    {
+        const float ceiling = juce::Decibels::decibelsToGain (-0.3f);
+
+        beginTest ("Bypassed: a pure delay of getLatencySamples()");
+        {
+            LookAheadLimiter limiter;
+            limiter.prepare (kSampleRate, 256, 2);
+            const int latency = limiter.getLatencySamples();
+
+            juce::AudioBuffer<float> buffer (2, 256);
+            buffer.clear();
+            buffer.setSample (0, 10, 0.5f);
+            buffer.setSample (1, 20, -0.25f);
+            limiter.process (buffer, 2, false);
+
+            expectEquals (buffer.getSample (0, 10 + latency), 0.5f);
+            expectEquals (buffer.getSample (1, 20 + latency), -0.25f);
+        }
+
+        beginTest ("Inter-sample peaks stay under the ceiling");
+        {
+            // fs/4 at 45 degrees: every sample sits 3 dB below the true peak,
+            // so a sample-peak limiter would let +2.7 dB through.
+            expectTruePeakLimited (kSampleRate / 4.0, juce::MathConstants<double>::pi / 4.0, ceiling, 0.1f);
+
+            // Near Nyquist, 4x detection under-reads by up to ~0.7 dB
+            expectTruePeakLimited (kSampleRate * 0.45, 0.3, ceiling, 0.7f);
+        }
+
+        beginTest ("Sample peaks never exceed the ceiling, whatever the block size");
+        {
+            for (const int blockSize : { 1, 7, 64, 512 })
+            {
+                LookAheadLimiter limiter;
+                limiter.prepare (kSampleRate, blockSize, 2);
+
+                auto random = getRandom();
+                juce::AudioBuffer<float> block (2, blockSize);
+                float worst = 0.0f;
+
+                for (int done = 0; done < 24000; done += blockSize)
+                {
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < blockSize; ++i)
+                            block.setSample (ch, i, (random.nextFloat() * 2.0f - 1.0f) * 4.0f);
+
+                    limiter.process (block, 2, true);
+                    for (int ch = 0; ch < 2; ++ch)
+                        worst = juce::jmax (worst, maxAbs (block.getReadPointer (ch), blockSize));
+                }
+
+                expectLessOrEqual (worst, ceiling * 1.0001f, "block size " + juce::String (blockSize));
+            }
+        }
+
+        beginTest ("Switched on mid-stream: never over the ceiling, delay line included");
+        {
+            for (const int blockSize : { 1, 64, 512 })
+            {
+                LookAheadLimiter limiter;
+                limiter.prepare (kSampleRate, blockSize, 2);
+
+                auto random = getRandom();
+                juce::AudioBuffer<float> block (2, blockSize);
+                float worst = 0.0f;
+
+                // Loud and bypassed, then on: the first samples out after the
+                // switch went into the delay line while it was still off
+                for (int done = 0; done < 12000; done += blockSize)
+                {
+                    const bool enabled = done >= 6000;
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < blockSize; ++i)
+                            block.setSample (ch, i, (random.nextFloat() * 2.0f - 1.0f) * 4.0f);
+
+                    limiter.process (block, 2, enabled);
+
+                    if (enabled)
+                        for (int ch = 0; ch < 2; ++ch)
+                            worst = juce::jmax (worst, maxAbs (block.getReadPointer (ch), blockSize));
+                }
+
+                expectLessOrEqual (worst, ceiling * 1.0001f, "block size " + juce::String (blockSize));
+            }
+        }
+
+        beginTest ("Switched off: the gain fades out over the look-ahead, no step");
+        {
+            LookAheadLimiter limiter;
+            limiter.prepare (kSampleRate, 256, 1);
+            const int window = limiter.getLatencySamples();
+
+            // Steady +6 dB DC: limited to the ceiling, then released
+            constexpr float level = 2.0f;
+            juce::AudioBuffer<float> block (1, 256);
+            float previous = 0.0f, largestStep = 0.0f, last = 0.0f;
+
+            for (int n = 0; n < 40; ++n)
+            {
+                for (int i = 0; i < 256; ++i)
+                    block.setSample (0, i, level);
+
+                limiter.process (block, 1, n < 20);
+
+                for (int i = 0; i < 256; ++i)
+                {
+                    const auto y = block.getSample (0, i);
+                    if (n >= 10)
+                        largestStep = juce::jmax (largestStep, std::abs (y - previous));
+                    previous = last = y;
+                }
+
+                if (n == 19)
+                    expect (last <= ceiling && last > ceiling * 0.9f, "limited before");
+            }
+
+            expectEquals (last, level, "unity after");
+
+            // A linear fade over the window (a little shorter than the latency)
+            expectLessOrEqual (largestStep, (level - ceiling) / static_cast<float> (window - 8), "largest step");
+        }
+    }
+
+private:
+    void expectTruePeakLimited (double frequency, double phase, float ceiling, float toleranceDb)
+    {
+        LookAheadLimiter limiter;
+        limiter.prepare (kSampleRate, 512, 2);
+
+        // +6 dB into the limiter, as with full output gain
+        juce::AudioBuffer<float> buffer (2, 24000);
+        fillSine (buffer, frequency, phase, 2.0f);
+        limiter.process (buffer, 2, true);
+
+        // Skip the attack; the release has settled by the second half
+        const auto amplitude = sineAmplitude (buffer.getReadPointer (0, 12000), 12000);
+        const auto overDb = juce::Decibels::gainToDecibels (amplitude / ceiling);
+
+        logMessage (juce::String (frequency, 0) + " Hz: true peak " + juce::String (overDb, 2) + " dB re ceiling");
+        expectLessOrEqual (overDb, toleranceDb);
+    }
+};
+
+static LookAheadLimiterTests lookAheadLimiterTests;
+
+//==============================================================================
+/**
+    Limiter vs bare gain, per block size. The limiter's cost per sample
+    should stay flat from small to large blocks.
+*/
+class LookAheadLimiterBenchmark : public juce::UnitTest
+{
+public:
+    LookAheadLimiterBenchmark() : juce::UnitTest ("LookAheadLimiter", benchmark::kCategory) {}
+
+    void runTest() override
+    {
+        beginTest ("ns per sample (stereo, 1 s of audio per run)");
+
+        constexpr int numSamples = 48000;
+        logMessage ("  block       gain    bypassed    limiting");
+
+        for (const int blockSize : { 16, 64, 256, 1024, 4096 })
+        {
+            LookAheadLimiter limiter;
+            limiter.prepare (kSampleRate, blockSize, 2);
+
+            juce::AudioBuffer<float> block (2, blockSize);
+            fillSine (block, 997.0, 0.0, 0.9f);
+
+            auto run = [&] (bool withLimiter, bool enabled)
+            {
+                return benchmark::measure (20, [&]
+                {
+                    for (int done = 0; done < numSamples; done += blockSize)
+                    {
+                        // Alternating gain keeps the level where the limiter works
+                        block.applyGain (done % (2 * blockSize) == 0 ? 2.0f : 0.5f);
+                        if (withLimiter)
+                            limiter.process (block, 2, enabled);
+                    }
+                }).median * 1000.0 / numSamples;
+            };
+
+            const auto gainOnly = run (false, false);
+            const auto bypassed = run (true, false);
+            const auto limiting = run (true, true);
+
+            logMessage (juce::String (blockSize).paddedLeft (' ', 7)
+                        + benchmark::format (gainOnly, 11) + benchmark::format (bypassed, 12) + benchmark::format (limiting, 12));
+        }
+    }
+};
+
+static LookAheadLimiterBenchmark lookAheadLimiterBenchmark;
@@ -0,0 +1,229 @@
+#include "hardware/MidiControlDecoder.h"
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    struct Decoded
+    {
+        int samplePosition;
+        ui_core::HardwareControlEvent event;
+    };
+
+    void addCC (juce::MidiBuffer& midi, int channel, int cc, int value, int samplePosition = 0)
+    {
+        const juce::uint8 bytes[] = { static_cast<juce::uint8> (0xb0 | channel),
+                                      static_cast<juce::uint8> (cc),
+                                      static_cast<juce::uint8> (value) };
+        midi.addEvent (bytes, 3, samplePosition);
+    }
+
+    std::vector<Decoded> decode (MidiControlDecoder& decoder, const juce::MidiBuffer& midi)
+    {
+        std::vector<Decoded> decoded;
+        decoder.process (midi, [&] (int samplePosition, const ui_core::HardwareControlEvent& event)
+        {
+            decoded.push_back ({ samplePosition, event });
+        });
+        return decoded;
+    }
+
+    std::vector<Decoded> decodeCC (MidiControlDecoder& decoder, int channel, int cc, int value)
+    {
+        juce::MidiBuffer midi;
+        addCC (midi, channel, cc, value);
+        return decode (decoder, midi);
+    }
+}
+
+//==============================================================================
+class MidiControlDecoderTests : public juce::UnitTest
+{
+public:
+    MidiControlDecoderTests() : juce::UnitTest ("MidiControlDecoder", "Hardware") {}
+
+    void runTest() override
+    {
+        beginTest ("7-bit and 14-bit CC keep their sample positions");
+        {
+            MidiControlDecoder decoder;
+            decoder.addMapping (MidiControlDecoder::Kind::cc7, 0, 74, 1001);
+            decoder.addMapping (MidiControlDecoder::Kind::cc14, 1, 7, 1002);
+
+            juce::MidiBuffer midi;
+            addCC (midi, 0, 74, 127, 10);
+            addCC (midi, 1, 7, 64, 100);     // MSB alone: nothing yet
+            addCC (midi, 1, 39, 0, 101);
+
+            const auto decoded = decode (decoder, midi);
+            expectEquals ((int) decoded.size(), 2);
+            expectEquals (decoded[0].samplePosition, 10);
+            expectEquals (decoded[0].event.controlId, (ui_core::ControlId) 1001);
+            expectEquals (decoded[0].event.normalizedValue, 1.0f);
+            expectEquals (decoded[1].samplePosition, 101);
+            expectEquals (decoded[1].event.controlId, (ui_core::ControlId) 1002);
+            expectEquals (decoded[1].event.normalizedValue, static_cast<float> (64 << 7) / 16383.0f);
+        }
+
+        beginTest ("NRPN resolves on CC 6 and is refined by CC 38");
+        {
+            MidiControlDecoder decoder;
+            decoder.addMapping (MidiControlDecoder::Kind::nrpn, 0, (3 << 7) | 5, 1003);
+
+            decodeCC (decoder, 0, 99, 3);
+            decodeCC (decoder, 0, 98, 5);
+
+            auto decoded = decodeCC (decoder, 0, 6, 127);
+            expectEquals ((int) decoded.size(), 1, "7-bit data entry");
+            expectEquals (decoded[0].event.normalizedValue, 1.0f);
+
+            decoded = decodeCC (decoder, 0, 6, 32);
+            expectEquals (decoded[0].event.normalizedValue, 32.0f / 127.0f);
+
+            decoded = decodeCC (decoder, 0, 38, 100);
+            expectEquals ((int) decoded.size(), 1, "14-bit refinement");
+            expectEquals (decoded[0].event.normalizedValue, static_cast<float> ((32 << 7) | 100) / 16383.0f);
+
+            // Data entry for an RPN is not ours
+            decodeCC (decoder, 0, 101, 0);
+            decodeCC (decoder, 0, 100, 0);
+            expect (decodeCC (decoder, 0, 6, 10).empty());
+            expect (decodeCC (decoder, 0, 38, 10).empty());
+        }
+
+        beginTest ("Learn: used at once, written to the table by the message thread");
+        {
+            MidiControlDecoder decoder;
+            decoder.addMapping (MidiControlDecoder::Kind::cc7, 0, 80, 1001);
+            decoder.consumeMappingChange();
+
+            decoder.startLearn (1001);
+            auto decoded = decodeCC (decoder, 2, 81, 64);
+            expectEquals ((int) decoded.size(), 1);
+            expectEquals (decoded[0].event.controlId, (ui_core::ControlId) 1001);
+            expectEquals (decoder.getLearnTarget(), (ui_core::ControlId) 0);
+            expect (! decoder.consumeMappingChange(), "the audio thread never writes the table");
+
+            expect (decoder.applyLearnedMapping());
+            expect (! decoder.applyLearnedMapping());
+            expect (decoder.consumeMappingChange());
+
+            juce::ValueTree state ("PluginState");
+            decoder.getState (state);
+            const auto mappings = state.getChildWithName ("MidiMappings");
+            expectEquals (mappings.getNumChildren(), 1, "the learned CC replaces the old one");
+            expectEquals (static_cast<int> (mappings.getChild (0).getProperty ("number")), 81);
+
+            expect (decodeCC (decoder, 0, 80, 1).empty());
+            expectEquals ((int) decodeCC (decoder, 2, 81, 1).size(), 1);
+        }
+
+        beginTest ("Learn waits to tell a 7-bit CC 0-31 from a 14-bit MSB");
+        {
+            MidiControlDecoder decoder;
+            decoder.startLearn (1002);
+            expect (decodeCC (decoder, 0, 1, 10).empty());
+            expectEquals ((int) decodeCC (decoder, 0, 33, 10).size(), 1);
+            decoder.applyLearnedMapping();
+
+            juce::ValueTree state ("PluginState");
+            decoder.getState (state);
+            expectEquals (static_cast<int> (state.getChildWithName ("MidiMappings").getChild (0).getProperty ("kind")),
+                          static_cast<int> (MidiControlDecoder::Kind::cc14));
+        }
+
+        beginTest ("A CC 32-63 is an LSB only after its MSB");
+        {
+            MidiControlDecoder decoder;
+            decoder.addMapping (MidiControlDecoder::Kind::cc7, 0, 45, 1001);
+
+            auto decoded = decodeCC (decoder, 0, 45, 127);
+            expectEquals ((int) decoded.size(), 1, "a plain 7-bit CC");
+            if (decoded.size() == 1)
+            {
+                expectEquals (decoded[0].event.controlId, (ui_core::ControlId) 1001);
+                expectEquals (decoded[0].event.normalizedValue, 1.0f);
+            }
+
+            decoder.startLearn (1002);
+            expectEquals ((int) decodeCC (decoder, 1, 40, 10).size(), 1);
+            decoder.applyLearnedMapping();
+
+            juce::ValueTree state ("PluginState");
+            decoder.getState (state);
+            const auto learned = state.getChildWithName ("MidiMappings").getChildWithProperty ("controlId", 1002);
+            expectEquals (static_cast<int> (learned.getProperty ("kind")), static_cast<int> (MidiControlDecoder::Kind::cc7),
+                          "learned as 7-bit, not as the LSB of CC 8");
+            expectEquals (static_cast<int> (learned.getProperty ("number")), 40);
+
+            // Once CC 8 has been seen, CC 40 completes the pair
+            decoder.addMapping (MidiControlDecoder::Kind::cc14, 1, 8, 1003);
+            decodeCC (decoder, 1, 8, 64);
+            decoded = decodeCC (decoder, 1, 40, 0);
+            expectEquals ((int) decoded.size(), 1);
+            if (decoded.size() == 1)
+            {
+                expectEquals (decoded[0].event.controlId, (ui_core::ControlId) 1003);
+                expectEquals (decoded[0].event.normalizedValue, static_cast<float> (64 << 7) / 16383.0f);
+            }
+        }
+
+        beginTest ("Learning on the audio thread while the message thread edits");
+        {
+            MidiControlDecoder decoder;
+            std::atomic<bool> running { true };
+
+            std::thread audio ([&]
+            {
+                juce::MidiBuffer midi;
+                for (int n = 0; running.load (std::memory_order_relaxed); ++n)
+                {
+                    midi.clear();
+                    addCC (midi, n % 16, 64 + n % 32, n & 0x7f);
+                    decoder.process (midi, [] (int, const ui_core::HardwareControlEvent&) {});
+                }
+            });
+
+            auto random = getRandom();
+            const auto endTime = juce::Time::getMillisecondCounter() + 300;
+
+            while (juce::Time::getMillisecondCounter() < endTime)
+            {
+                const auto controlId = static_cast<ui_core::ControlId> (1001 + random.nextInt (8));
+
+                switch (random.nextInt (4))
+                {
+                    case 0:  decoder.startLearn (controlId); break;
+                    case 1:  decoder.addMapping (MidiControlDecoder::Kind::cc7, random.nextInt (16), 64 + random.nextInt (32), controlId); break;
+                    case 2:  decoder.removeMappingsFor (controlId); break;
+                    default: decoder.applyLearnedMapping(); break;
+                }
+            }
+
+            running = false;
+            audio.join();
+            decoder.applyLearnedMapping();
+
+            // The table's invariant survives: one source per control and back
+            juce::ValueTree state ("PluginState");
+            decoder.getState (state);
+
+            std::set<juce::int64> controls;
+            std::set<juce::int64> sources;
+            for (const auto& mapping : state.getChildWithName ("MidiMappings"))
+            {
+                controls.insert (static_cast<juce::int64> (mapping.getProperty ("controlId")));
+                sources.insert (static_cast<juce::int64> (mapping.getProperty ("channel")) << 16
+                                | static_cast<juce::int64> (mapping.getProperty ("number")));
+            }
+
+            const auto numMappings = state.getChildWithName ("MidiMappings").getNumChildren();
+            expectEquals ((int) controls.size(), numMappings, "one mapping per control");
+            expectEquals ((int) sources.size(), numMappings, "one mapping per source");
+        }
+    }
+};
+
+static MidiControlDecoderTests midiControlDecoderTests;
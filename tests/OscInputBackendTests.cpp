@@ -0,0 +1,371 @@
+#include "hardware/OscInputBackend.h"
+#include "Benchmark.h"
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /** Builds OSC packets by hand; the plugin doesn't link juce_osc. */
+    struct OscWriter
+    {
+        std::vector<char> bytes;
+
+        OscWriter& string (const char* text)
+        {
+            bytes.insert (bytes.end(), text, text + std::strlen (text));
+            do { bytes.push_back (0); } while (bytes.size() % 4 != 0);
+            return *this;
+        }
+
+        OscWriter& int32 (juce::uint32 value)
+        {
+            for (int shift = 24; shift >= 0; shift -= 8)
+                bytes.push_back (static_cast<char> ((value >> shift) & 0xff));
+            return *this;
+        }
+
+        OscWriter& float32 (float value)
+        {
+            juce::uint32 bits;
+            std::memcpy (&bits, &value, sizeof (bits));
+            return int32 (bits);
+        }
+
+        OscWriter& float64 (double value)
+        {
+            juce::uint64 bits;
+            std::memcpy (&bits, &value, sizeof (bits));
+            int32 (static_cast<juce::uint32> (bits >> 32));
+            return int32 (static_cast<juce::uint32> (bits));
+        }
+
+        /** Appends a bundle element: size, then the packet. */
+        OscWriter& element (const OscWriter& packet)
+        {
+            int32 (static_cast<juce::uint32> (packet.bytes.size()));
+            bytes.insert (bytes.end(), packet.bytes.begin(), packet.bytes.end());
+            return *this;
+        }
+
+        int size() const noexcept  { return static_cast<int> (bytes.size()); }
+    };
+
+    OscWriter message (const char* address, const char* tags)
+    {
+        OscWriter writer;
+        writer.string (address).string (tags);
+        return writer;
+    }
+
+    OscWriter bundle()
+    {
+        OscWriter writer;
+        writer.string ("#bundle").int32 (0).int32 (1);    // time tag "immediately"
+        return writer;
+    }
+
+    OscWriter nestedBundles (int depth, const OscWriter& innermost)
+    {
+        auto packet = innermost;
+        for (int i = 0; i < depth; ++i)
+            packet = bundle().element (packet);
+        return packet;
+    }
+
+    struct RecordingTarget : ui_core::HardwareInputAdapter
+    {
+        void processEvent (const ui_core::HardwareControlEvent& event) override  { events.push_back (event); }
+
+        std::vector<ui_core::HardwareControlEvent> events;
+    };
+
+    //==============================================================================
+    /** A backend on an ephemeral localhost port and a socket sending to it. */
+    struct LocalLink
+    {
+        explicit LocalLink (ui_core::HardwareInputAdapter& target) : osc (target)
+        {
+            osc.addAddress ("/gain", 1);
+            osc.addAddress ("/gain/delta", 1, true);
+            osc.addAddress ("/mix", 2);
+            ok = osc.start (0);
+        }
+
+        void send (const OscWriter& packet)
+        {
+            sender.write ("127.0.0.1", osc.getPort(), packet.bytes.data(), packet.size());
+            ++numSent;
+        }
+
+        /** Waits until every sent datagram was read, then forwards its events. */
+        bool receive (bool deliver = true)
+        {
+            const auto timeout = juce::Time::getMillisecondCounter() + 2000;
+            while (osc.getNumReceived() < numSent)
+            {
+                if (juce::Time::getMillisecondCounter() > timeout)
+                    return false;
+
+                juce::Thread::sleep (1);
+            }
+
+            if (deliver)
+                osc.deliverPendingEvents();
+
+            return true;
+        }
+
+        OscInputBackend osc;
+        juce::DatagramSocket sender;
+        juce::uint32 numSent = 0;
+        bool ok = false;
+    };
+}
+
+//==============================================================================
+/**
+    Sends real datagrams over localhost to an OscInputBackend and checks what
+    reaches the input adapter.
+*/
+class OscInputBackendTests : public juce::UnitTest
+{
+public:
+    OscInputBackendTests() : juce::UnitTest ("OscInputBackend", "Hardware") {}
+
+    void runTest() override
+    {
+        beginTest ("Address lookup");
+        {
+            RecordingTarget target;
+            LocalLink link (target);
+            expect (link.ok);
+            expectGreaterThan (link.osc.getPort(), 0);
+
+            link.send (message ("/gain", ",f").float32 (0.25f));
+            link.send (message ("/gai", ",f").float32 (0.5f));
+            link.send (message ("/gainx", ",f").float32 (0.5f));
+            link.send (message ("/mix", ",i").int32 (1));
+            link.send (message ("/gain/delta", ",f").float32 (-0.1f));
+            expect (link.receive());
+
+            expectEquals ((int) target.events.size(), 3, "unmapped addresses ignored");
+            if (target.events.size() == 3)
+            {
+                expectEvent (target.events[0], 1, 0.25f, false);
+                expectEvent (target.events[1], 2, 1.0f, false);
+                expectEvent (target.events[2], 1, -0.1f, true);
+            }
+
+            expectEquals ((int) link.osc.getNumRejected(), 0);
+        }
+
+        beginTest ("f, i, d, T and F; absolute values clamped to 0..1");
+        {
+            RecordingTarget target;
+            LocalLink link (target);
+
+            link.send (message ("/gain", ",f").float32 (0.5f));
+            link.send (message ("/gain", ",i").int32 (0));
+            link.send (message ("/gain", ",d").float64 (0.75));
+            link.send (message ("/gain", ",T"));
+            link.send (message ("/gain", ",F"));
+            link.send (message ("/gain", ",i").int32 (5));
+            link.send (message ("/gain", ",f").float32 (-2.0f));
+            link.send (message ("/gain/delta", ",f").float32 (-2.0f));
+            link.send (message ("/gain", ",fi").float32 (0.125f).int32 (1));
+            expect (link.receive());
+
+            const float expected[] = { 0.5f, 0.0f, 0.75f, 1.0f, 0.0f, 1.0f, 0.0f, -2.0f, 0.125f };
+            expectEquals ((int) target.events.size(), (int) std::size (expected));
+
+            for (size_t i = 0; i < juce::jmin (target.events.size(), std::size (expected)); ++i)
+                expectEquals (target.events[i].normalizedValue, expected[i]);
+        }
+
+        beginTest ("NaN and infinity never reach the adapter");
+        {
+            RecordingTarget target;
+            LocalLink link (target);
+
+            link.send (message ("/gain", ",f").float32 (std::numeric_limits<float>::quiet_NaN()));
+            link.send (message ("/gain", ",f").float32 (std::numeric_limits<float>::infinity()));
+            link.send (message ("/gain/delta", ",d").float64 (-std::numeric_limits<double>::infinity()));
+            link.send (message ("/gain", ",d").float64 (1.0e300));     // inf as a float
+            expect (link.receive());
+
+            expect (target.events.empty());
+            expectEquals ((int) link.osc.getNumRejected(), 4);
+        }
+
+        beginTest ("Truncated and oversized packets are rejected");
+        {
+            RecordingTarget target;
+            LocalLink link (target);
+
+            // Missing argument, unterminated address, bundle element past the end
+            link.send (message ("/gain", ",f"));
+            OscWriter unterminated;
+            unterminated.bytes = { '/', 'g', 'a', 'i' };
+            link.send (unterminated);
+            auto cut = bundle().element (message ("/gain", ",f").float32 (0.5f));
+            cut.bytes.resize (cut.bytes.size() - 4);
+            link.send (cut);
+
+            // Valid messages, but more than kMaxPacketSize of them
+            auto oversized = bundle();
+            while (oversized.size() <= OscInputBackend::kMaxPacketSize)
+                oversized.element (message ("/gain", ",f").float32 (0.5f));
+            link.send (oversized);
+
+            expect (link.receive());
+            expect (target.events.empty());
+            expectEquals ((int) link.osc.getNumRejected(), 4);
+        }
+
+        beginTest ("Bundles nest up to kMaxBundleDepth");
+        {
+            RecordingTarget target;
+            LocalLink link (target);
+            const auto innermost = message ("/mix", ",f").float32 (0.5f);
+
+            link.send (nestedBundles (OscInputBackend::kMaxBundleDepth, innermost));
+            link.send (nestedBundles (OscInputBackend::kMaxBundleDepth + 1, innermost));
+            expect (link.receive());
+
+            expectEquals ((int) target.events.size(), 1);
+            expectEquals ((int) link.osc.getNumRejected(), 1, "the deeper one");
+        }
+
+        beginTest ("A full queue counts what it drops");
+        {
+            RecordingTarget target;
+            LocalLink link (target);
+
+            constexpr int perBundle = 400;
+            constexpr int numBundles = 12;
+            const auto packet = fullBundle (perBundle);
+
+            // Nothing delivered until all of it has been read
+            for (int i = 0; i < numBundles; ++i)
+                link.send (packet);
+
+            expect (link.receive (false));
+            link.osc.deliverPendingEvents();
+
+            constexpr int total = perBundle * numBundles;
+            expectEquals ((int) target.events.size(), 4096, "queue capacity");
+            expectEquals ((int) link.osc.getNumDropped(), total - 4096);
+        }
+
+        beginTest ("A port in use: the next one of the range is taken");
+        {
+            RecordingTarget target;
+            LocalLink first (target);
+
+            OscInputBackend second (target);
+            expect (! second.start (first.osc.getPort()), "the same port alone fails, without throwing");
+            expectEquals (second.getPort(), 0);
+
+            expect (second.start (first.osc.getPort(), "127.0.0.1", 8));
+            expect (second.getPort() != first.osc.getPort());
+        }
+    }
+
+    /** As many "/gain" messages as fit the packet size limit, up to n. */
+    static OscWriter fullBundle (int n)
+    {
+        auto packet = bundle();
+        for (int i = 0; i < n; ++i)
+            packet.element (message ("/gain", ",f").float32 (static_cast<float> (i) / static_cast<float> (n)));
+
+        jassert (packet.size() <= OscInputBackend::kMaxPacketSize);
+        return packet;
+    }
+
+private:
+    void expectEvent (const ui_core::HardwareControlEvent& event, ui_core::ControlId controlId, float value, bool relative)
+    {
+        expectEquals (event.controlId, controlId);
+        expectEquals (event.normalizedValue, value);
+        expect (event.isRelative == relative);
+    }
+};
+
+static OscInputBackendTests oscInputBackendTests;
+
+//==============================================================================
+/**
+    End-to-end messages per second over localhost: a sender thread floods the
+    backend while this thread forwards events, as the message thread would.
+    Datagrams the OS dropped and events the full queue dropped are logged
+    next to the rate.
+*/
+class OscInputBackendBenchmark : public juce::UnitTest
+{
+public:
+    OscInputBackendBenchmark() : juce::UnitTest ("OscInputBackend", benchmark::kCategory) {}
+
+    void runTest() override
+    {
+        beginTest ("Messages per second");
+
+        logMessage ("  messages/datagram   messages/s   datagrams lost   events dropped");
+
+        for (const int perPacket : { 1, 20, 400 })
+        {
+            struct CountingTarget : ui_core::HardwareInputAdapter
+            {
+                void processEvent (const ui_core::HardwareControlEvent&) override  { ++count; }
+                int count = 0;
+            } target;
+
+            LocalLink link (target);
+            const auto packet = perPacket == 1 ? message ("/gain", ",f").float32 (0.5f)
+                                               : OscInputBackendTests::fullBundle (perPacket);
+            const int numPackets = 200000 / perPacket;
+
+            const auto start = juce::Time::getHighResolutionTicks();
+
+            std::thread sender ([&]
+            {
+                for (int i = 0; i < numPackets; ++i)
+                    link.send (packet);
+            });
+
+            // Until the sender is done and nothing more arrives for 50 ms
+            auto lastCount = -1;
+            auto quietSince = juce::Time::getMillisecondCounter();
+            auto end = start;
+
+            for (;;)
+            {
+                link.osc.deliverPendingEvents();
+
+                if (target.count != lastCount)
+                {
+                    lastCount = target.count;
+                    quietSince = juce::Time::getMillisecondCounter();
+                    end = juce::Time::getHighResolutionTicks();
+                }
+                else if (juce::Time::getMillisecondCounter() - quietSince > 50 && link.numSent == (juce::uint32) numPackets)
+                {
+                    break;
+                }
+
+                std::this_thread::yield();
+            }
+
+            sender.join();
+
+            const auto seconds = juce::Time::highResolutionTicksToSeconds (end - start);
+            logMessage (juce::String (perPacket).paddedLeft (' ', 19)
+                        + juce::String (static_cast<double> (target.count) / seconds, 0).paddedLeft (' ', 13)
+                        + juce::String ((int) (numPackets - (int) link.osc.getNumReceived())).paddedLeft (' ', 17)
+                        + juce::String ((int) link.osc.getNumDropped()).paddedLeft (' ', 17));
+        }
+    }
+};
+
+static OscInputBackendBenchmark oscInputBackendBenchmark;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "parameters/Parameters.h"
+
+//==============================================================================
+/**
+    Bare AudioProcessor that owns the HostParameters of a Parameters, so a
+    test can play host (automation writes, gesture and change notifications)
+    without the rest of the plugin.
+*/
+class ParameterHost : public juce::AudioProcessor
+{
+public:
+    explicit ParameterHost (Parameters& parameters)  { parameters.createHostParameters (*this); }
+
+    const juce::String getName() const override                                 { return "ParameterHost"; }
+    void prepareToPlay (double, int) override                                   {}
+    void releaseResources() override                                            {}
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override   {}
+    using AudioProcessor::processBlock;
+    double getTailLengthSeconds() const override                                { return 0.0; }
+    bool acceptsMidi() const override                                           { return false; }
+    bool producesMidi() const override                                          { return false; }
+    juce::AudioProcessorEditor* createEditor() override                         { return nullptr; }
+    bool hasEditor() const override                                             { return false; }
+    int getNumPrograms() override                                               { return 1; }
+    int getCurrentProgram() override                                            { return 0; }
+    void setCurrentProgram (int) override                                       {}
+    const juce::String getProgramName (int) override                            { return {}; }
+    void changeProgramName (int, const juce::String&) override                  {}
+    void getStateInformation (juce::MemoryBlock&) override                      {}
+    void setStateInformation (const void*, int) override                        {}
+
+private:
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterHost)
+};
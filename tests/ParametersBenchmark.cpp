@@ -0,0 +1,99 @@
+#include "ParameterHost.h"
+#include "Benchmark.h"
+#include "hardware/HardwareEventQueue.h"
+#include <atomic>
+#include <thread>
+
+//==============================================================================
+/**
+    Throughput of the hot paths between threads: Parameters getters (alone
+    and while the host writes), message-thread setters, audio-thread writes
+    and the hardware event queue.
+*/
+class ParametersBenchmark : public juce::UnitTest
+{
+public:
+    ParametersBenchmark() : juce::UnitTest ("Parameters", benchmark::kCategory) {}
+
+    void runTest() override
+    {
+        beginTest ("ns per operation");
+
+        Parameters parameters;
+        ParameterHost host (parameters);
+
+        std::atomic<float> sink { 0.0f };
+
+        const auto getters = nsPerOp ([&]
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < kOps; ++i)
+                sum += parameters.getValue (static_cast<Parameters::Index> (i % Parameters::numHostParameters));
+            sink = sum;
+        });
+
+        // Same reads while a host thread keeps writing the same atomics
+        std::atomic<bool> writing { true };
+        std::thread automation ([&]
+        {
+            const auto& hostParameters = host.getParameters();
+            for (int n = 0; writing.load (std::memory_order_relaxed); ++n)
+                hostParameters[n % hostParameters.size()]->setValue (static_cast<float> (n % 101) / 100.0f);
+        });
+
+        const auto contendedGetters = nsPerOp ([&]
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < kOps; ++i)
+                sum += parameters.getValue (static_cast<Parameters::Index> (i % Parameters::numHostParameters));
+            sink = sum;
+        });
+
+        writing = false;
+        automation.join();
+
+        // Message-thread setter: clamp, undo journal, host notification
+        const auto setters = nsPerOp ([&]
+        {
+            for (int i = 0; i < kOps; ++i)
+                parameters.setGain (static_cast<float> (i & 1));
+        });
+
+        const auto audioWrites = nsPerOp ([&]
+        {
+            for (int i = 0; i < kOps; ++i)
+                parameters.setNormalisedFromAudioThread (Parameters::mixIndex, static_cast<float> (i & 1));
+        });
+
+        HardwareEventQueue queue (1024);
+        const auto queueRoundTrip = nsPerOp ([&]
+        {
+            float sum = 0.0f;
+            for (int done = 0; done < kOps; done += 512)
+            {
+                for (int i = 0; i < 512; ++i)
+                    queue.push ({ 1001, 0.5f, false });
+
+                queue.drain ([&] (const ui_core::HardwareControlEvent& event) { sum += event.normalizedValue; });
+            }
+            sink = sum;
+        });
+
+        logMessage ("getValue                       " + benchmark::format (getters));
+        logMessage ("getValue, host writing         " + benchmark::format (contendedGetters));
+        logMessage ("setValue (message thread)      " + benchmark::format (setters));
+        logMessage ("setNormalisedFromAudioThread   " + benchmark::format (audioWrites));
+        logMessage ("HardwareEventQueue push+drain  " + benchmark::format (queueRoundTrip));
+    }
+
+private:
+    static constexpr int kOps = 100000;
+
+    template <typename Fn>
+    static double nsPerOp (Fn&& fn)
+    {
+        return benchmark::measure (15, fn, 2).median * 1000.0 / kOps;
+    }
+};
+
+static ParametersBenchmark parametersBenchmark;
@@ -0,0 +1,218 @@
+#include <juce_audio_basics/juce_audio_basics.h>
+#include "debug/RealtimeGuard.h"
+#include "parameters/Parameters.h"
+#include "dsp/LookAheadLimiter.h"
+#include "hardware/HardwareEventQueue.h"
+#include "hardware/MidiControlDecoder.h"
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+
+namespace
+{
+    // Escapes every allocation, so the compiler can't elide new/delete pairs
+    void* volatile sink = nullptr;
+
+    struct alignas (64) AlignedBlock { float samples[16]; };
+
+    /** True if report has a "#n <what>" entry. */
+    [[maybe_unused]] bool wasReported (const juce::String& report, const juce::String& what)
+    {
+        for (const auto& line : juce::StringArray::fromLines (report))
+            if (line.startsWithChar ('#') && line.fromFirstOccurrenceOf (" ", false, false) == what)
+                return true;
+
+        return false;
+    }
+}
+
+//==============================================================================
+/**
+    Allocates and locks inside RealtimeGuard::ScopedAudioContext and checks
+    the report names each call, then runs the audio-thread code paths under
+    the same guard and checks they stay silent.
+
+    PluginTests builds with PLUGIN_REALTIME_CHECKS unless a sanitizer is on
+    (both replace malloc and the pthread locks).
+*/
+class RealtimeGuardTests : public juce::UnitTest
+{
+public:
+    RealtimeGuardTests() : juce::UnitTest ("RealtimeGuard", "Threading") {}
+
+    void runTest() override
+    {
+       #if PLUGIN_REALTIME_CHECKS
+        beginTest ("Nothing is recorded outside a guarded scope");
+        {
+            RealtimeGuard::clear();
+            sink = new int (1);
+            delete static_cast<int*> (sink);
+
+            std::mutex mutex;
+            mutex.lock();
+            mutex.unlock();
+
+            expectEquals (RealtimeGuard::getNumViolations(), 0);
+        }
+
+        beginTest ("operator new/delete, plain and aligned");
+        {
+            expectReported ({ "operator new", "operator delete" }, []
+            {
+                sink = new int (1);
+                delete static_cast<int*> (sink);
+            });
+
+            expectReported ({ "operator new[]", "operator delete[]" }, []
+            {
+                sink = new float[64];
+                delete[] static_cast<float*> (sink);
+            });
+
+            expectReported ({ "operator new (aligned)", "operator delete (aligned)" }, []
+            {
+                auto* block = new AlignedBlock();
+                sink = block;
+                delete block;
+            });
+        }
+
+       #if JUCE_LINUX || JUCE_MAC
+        beginTest ("malloc, calloc, realloc, free");
+        {
+            expectReported ({ "malloc", "calloc", "realloc", "free" }, []
+            {
+                sink = std::malloc (64);
+                std::free (sink);
+                sink = std::calloc (16, sizeof (float));
+                sink = std::realloc (sink, 256);
+                std::free (sink);
+            });
+        }
+
+        beginTest ("Mutex, rwlock and condition variable");
+        {
+            std::mutex mutex;
+            expectReported ({ "pthread_mutex_lock", "pthread_mutex_trylock" }, [&]
+            {
+                mutex.lock();
+                mutex.unlock();
+
+                if (mutex.try_lock())
+                    mutex.unlock();
+            });
+
+            std::shared_mutex rwLock;
+            expectReported ({ "pthread_rwlock_rdlock", "pthread_rwlock_wrlock",
+                              "pthread_rwlock_tryrdlock", "pthread_rwlock_trywrlock" }, [&]
+            {
+                rwLock.lock_shared();
+                rwLock.unlock_shared();
+                rwLock.lock();
+                rwLock.unlock();
+
+                if (rwLock.try_lock_shared())
+                    rwLock.unlock_shared();
+
+                if (rwLock.try_lock())
+                    rwLock.unlock();
+            });
+
+            // wait_for ends up in timedwait or, with newer glibc, clockwait
+            std::condition_variable condition;
+            std::unique_lock<std::mutex> lock (mutex);
+            RealtimeGuard::clear();
+            {
+                const RealtimeGuard::ScopedAudioContext audioContext;
+                condition.wait_for (lock, std::chrono::milliseconds (1));
+            }
+
+            const auto report = RealtimeGuard::getReport();
+            expect (wasReported (report, "pthread_cond_timedwait") || wasReported (report, "pthread_cond_clockwait"),
+                    "condition variable wait not reported:" + juce::String (juce::newLine) + report);
+        }
+       #endif
+
+        beginTest ("The report can be saved");
+        {
+            RealtimeGuard::clear();
+            {
+                const RealtimeGuard::ScopedAudioContext audioContext;
+                sink = new int (1);
+            }
+            delete static_cast<int*> (sink);
+
+            const auto file = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                  .getNonexistentChildFile ("RealtimeGuardReport", ".log");
+
+            expect (RealtimeGuard::appendReportTo (file));
+            expect (wasReported (file.loadFileAsString(), "operator new"));
+            file.deleteFile();
+
+            RealtimeGuard::clear();
+            expect (! RealtimeGuard::appendReportTo (file), "nothing recorded, nothing written");
+            expect (! file.exists());
+        }
+
+        beginTest ("Audio-thread code paths neither allocate nor lock");
+        {
+            Parameters parameters;
+            LookAheadLimiter limiter;
+            limiter.prepare (48000.0, 256, 2);
+            MidiControlDecoder midiDecoder;
+            midiDecoder.addMapping (MidiControlDecoder::Kind::cc7, 0, 20, 1001);
+            HardwareEventQueue queue (64);
+
+            juce::AudioBuffer<float> buffer (2, 256);
+            juce::MidiBuffer midi;
+            const juce::uint8 cc[] = { 0xb0, 20, 100 };
+            midi.addEvent (cc, 3, 0);
+
+            RealtimeGuard::clear();
+            {
+                const RealtimeGuard::ScopedAudioContext audioContext;
+
+                midiDecoder.process (midi, [&] (int, const ui_core::HardwareControlEvent& event)
+                {
+                    queue.push (event);
+                });
+
+                parameters.setNormalisedFromAudioThread (Parameters::mixIndex, 0.5f);
+
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    buffer.setSample (0, i, parameters.getGain() * 2.0f * static_cast<float> (i % 2));
+
+                limiter.process (buffer, 2, parameters.getLimiterEnabled());
+            }
+
+            expectEquals (RealtimeGuard::getNumViolations(), 0, RealtimeGuard::getReport());
+        }
+
+        RealtimeGuard::clear();
+       #else
+        beginTest ("Checks compiled out");
+        logMessage ("Built without PLUGIN_REALTIME_CHECKS (sanitizer build); nothing to check");
+       #endif
+    }
+
+private:
+   #if PLUGIN_REALTIME_CHECKS
+    template <typename Fn>
+    void expectReported (std::initializer_list<const char*> expected, Fn&& fn)
+    {
+        RealtimeGuard::clear();
+        {
+            const RealtimeGuard::ScopedAudioContext audioContext;
+            fn();
+        }
+
+        const auto report = RealtimeGuard::getReport();
+        for (const auto* what : expected)
+            expect (wasReported (report, what), juce::String (what) + " not reported:" + juce::newLine + report);
+    }
+   #endif
+};
+
+static RealtimeGuardTests realtimeGuardTests;
@@ -0,0 +1,158 @@
+#include "dsp/SidechainDucker.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 512;
+    constexpr float kThresholdDb = -30.0f;
+    constexpr float kDepthDb = 12.0f;
+}
+
+//==============================================================================
+/**
+    EnvelopeFollower timing against its one-pole definition, then the
+    ducker's gain curve and reduction meter on steady (DC) sidechains, where
+    the settled envelope is exactly the sidechain level.
+*/
+class SidechainDuckerTests : public juce::UnitTest
+{
+public:
+    SidechainDuckerTests() : juce::UnitTest ("SidechainDucker", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest ("Follower: 63% of a step up after the attack time, 37% left after the release time");
+        {
+            EnvelopeFollower follower;
+            follower.prepare (kSampleRate, SidechainDucker::kAttackMs, SidechainDucker::kReleaseMs);
+
+            const auto attackSamples = juce::roundToInt (kSampleRate * SidechainDucker::kAttackMs / 1000.0);
+            const auto releaseSamples = juce::roundToInt (kSampleRate * SidechainDucker::kReleaseMs / 1000.0);
+
+            std::vector<float> up ((size_t) attackSamples, 1.0f);
+            follower.process (up.data(), attackSamples);
+            expectWithinAbsoluteError (up.back(), 1.0f - std::exp (-1.0f), 1.0e-3f);
+
+            // Settle at 1, then let go
+            std::vector<float> hold ((size_t) releaseSamples * 4, 1.0f);
+            follower.process (hold.data(), (int) hold.size());
+            expectWithinAbsoluteError (hold.back(), 1.0f, 1.0e-4f);
+
+            std::vector<float> down ((size_t) releaseSamples, 0.0f);
+            follower.process (down.data(), releaseSamples);
+            expectWithinAbsoluteError (down.back(), std::exp (-1.0f), 1.0e-3f);
+        }
+
+        beginTest ("Follower: split blocks give the same envelope as one");
+        {
+            EnvelopeFollower whole, split;
+            whole.prepare (kSampleRate, 1.0f, 50.0f);
+            split.prepare (kSampleRate, 1.0f, 50.0f);
+
+            auto random = getRandom();
+            std::vector<float> a (4000);
+            for (auto& x : a)
+                x = random.nextFloat();
+            auto b = a;
+
+            whole.process (a.data(), (int) a.size());
+            for (int pos = 0; pos < (int) b.size(); pos += 333)
+                split.process (b.data() + pos, juce::jmin (333, (int) b.size() - pos));
+
+            expect (a == b);
+        }
+
+        beginTest ("No reduction below the threshold");
+        {
+            SidechainDucker ducker;
+            ducker.prepare (kSampleRate, kBlockSize);
+
+            expectEquals (settledGain (ducker, kThresholdDb - 10.0f), 1.0f);
+            expectEquals (settledGain (ducker, kThresholdDb - 0.1f), 1.0f);
+            expectEquals (ducker.consumePeakReductionDb(), 0.0f);
+        }
+
+        beginTest ("Full depth from 6 dB above the threshold, halfway in between");
+        {
+            SidechainDucker ducker;
+            ducker.prepare (kSampleRate, kBlockSize);
+            const auto depthGain = juce::Decibels::decibelsToGain (-kDepthDb);
+
+            expectWithinAbsoluteError (settledGain (ducker, kThresholdDb + 20.0f), depthGain, 1.0e-5f);
+            expectWithinAbsoluteError (settledGain (ducker, kThresholdDb + 6.03f), depthGain, 1.0e-4f);
+
+            // 1.5 x the threshold: half the reduction, in gain
+            const auto halfwayDb = kThresholdDb + juce::Decibels::gainToDecibels (1.5f);
+            expectWithinAbsoluteError (settledGain (ducker, halfwayDb), 1.0f - 0.5f * (1.0f - depthGain), 1.0e-4f);
+        }
+
+        beginTest ("Channels are linked on the loudest one");
+        {
+            SidechainDucker ducker;
+            ducker.prepare (kSampleRate, kBlockSize);
+
+            // Silent left channel, loud (and negative) right channel
+            juce::AudioBuffer<float> sidechain (2, kBlockSize);
+            const float* curve = nullptr;
+
+            for (int block = 0; block < 200; ++block)
+            {
+                sidechain.clear();
+                for (int i = 0; i < kBlockSize; ++i)
+                    sidechain.setSample (1, i, -juce::Decibels::decibelsToGain (kThresholdDb + 20.0f));
+
+                curve = ducker.computeGainCurve (sidechain, 0, kBlockSize, kThresholdDb, kDepthDb);
+            }
+
+            expectWithinAbsoluteError (curve[kBlockSize - 1], juce::Decibels::decibelsToGain (-kDepthDb), 1.0e-5f);
+        }
+
+        beginTest ("The meter holds the largest reduction until it is read");
+        {
+            SidechainDucker ducker;
+            ducker.prepare (kSampleRate, kBlockSize);
+
+            settledGain (ducker, kThresholdDb + 20.0f);
+            expectWithinAbsoluteError (ducker.consumePeakReductionDb(), kDepthDb, 1.0e-3f);
+            expectEquals (ducker.consumePeakReductionDb(), 0.0f, "reset by reading");
+
+            // A burst, then a second of quiet before the UI looks
+            ducker.reset();
+            runBlocks (ducker, kThresholdDb + 20.0f, 20);
+            runBlocks (ducker, -100.0f, 100);
+            expectWithinAbsoluteError (ducker.consumePeakReductionDb(), kDepthDb, 0.1f);
+
+            runBlocks (ducker, -100.0f, 1);
+            expectEquals (ducker.consumePeakReductionDb(), 0.0f, "released by now");
+        }
+    }
+
+private:
+    /** Runs numBlocks of a constant sidechain at levelDb; returns the last curve. */
+    static const float* runBlocks (SidechainDucker& ducker, float levelDb, int numBlocks)
+    {
+        juce::AudioBuffer<float> sidechain (2, kBlockSize);
+        for (int ch = 0; ch < 2; ++ch)
+            for (int i = 0; i < kBlockSize; ++i)
+                sidechain.setSample (ch, i, juce::Decibels::decibelsToGain (levelDb));
+
+        const float* curve = nullptr;
+        for (int block = 0; block < numBlocks; ++block)
+            curve = ducker.computeGainCurve (sidechain, 0, kBlockSize, kThresholdDb, kDepthDb);
+
+        return curve;
+    }
+
+    /** Gain after 2 s of a constant sidechain, from silence: the attack has
+        long settled and the whole last block is flat. */
+    static float settledGain (SidechainDucker& ducker, float levelDb)
+    {
+        ducker.reset();
+        const auto* curve = runBlocks (ducker, levelDb, (int) (2.0 * kSampleRate) / kBlockSize);
+        return curve[0] == curve[kBlockSize - 1] ? curve[kBlockSize - 1] : -1.0f;
+    }
+};
+
+static SidechainDuckerTests sidechainDuckerTests;
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <ui_core/UiCore.h>
+
+//==============================================================================
+/** Hardware feedback sink for tests; the plugin's default adapter logs every
+    LED and focus change. */
+struct SilentOutput : ui_core::HardwareOutputAdapter
+{
+    void setLEDValue (ui_core::ControlId, float) override  {}
+    void setFocus (ui_core::ControlId, bool) override      {}
+};
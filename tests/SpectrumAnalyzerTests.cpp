@@ -0,0 +1,114 @@
+#include "dsp/SpectrumAnalyzer.h"
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+namespace
+{
+    constexpr double kSampleRate = 48000.0;
+
+    void pushSine (SpectrumAnalyzer& analyzer, double frequency, float amplitude, int numSamples, int blockSize = 512)
+    {
+        juce::AudioBuffer<float> block (2, blockSize);
+        for (int done = 0; done < numSamples; done += blockSize)
+        {
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    block.setSample (ch, i, amplitude * static_cast<float> (std::sin (juce::MathConstants<double>::twoPi * frequency * (done + i) / kSampleRate)));
+
+            analyzer.pushSamples (block, 2);
+        }
+    }
+
+    int loudestPoint (const SpectrumAnalyzer& analyzer)
+    {
+        const auto& levels = analyzer.getLevels();
+        return static_cast<int> (std::max_element (levels.begin(), levels.end()) - levels.begin());
+    }
+}
+
+//==============================================================================
+class SpectrumAnalyzerTests : public juce::UnitTest
+{
+public:
+    SpectrumAnalyzerTests() : juce::UnitTest ("SpectrumAnalyzer", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest ("A full-scale sine reads about 0 dB, higher tones further right");
+        {
+            int previousPoint = -1;
+
+            for (const double frequency : { 250.0, 1000.0, 4000.0, 16000.0 })
+            {
+                SpectrumAnalyzer analyzer;
+                analyzer.prepare (kSampleRate);
+                analyzer.setActive (true);
+
+                pushSine (analyzer, frequency, 1.0f, SpectrumAnalyzer::kFftSize * 2);
+                expect (analyzer.process());
+
+                const auto point = loudestPoint (analyzer);
+                expectGreaterThan (point, previousPoint, juce::String (frequency, 0) + " Hz");
+                expectWithinAbsoluteError (analyzer.getLevels()[(size_t) point], 1.0f, 0.05f);
+                previousPoint = point;
+            }
+        }
+
+        beginTest ("Inactive: nothing is queued; reopening starts from silence");
+        {
+            SpectrumAnalyzer analyzer;
+            analyzer.prepare (kSampleRate);
+            analyzer.setActive (true);
+            pushSine (analyzer, 1000.0, 1.0f, SpectrumAnalyzer::kFftSize);
+            analyzer.process();
+
+            // Left in the FIFO when the view closes
+            pushSine (analyzer, 5000.0, 1.0f, SpectrumAnalyzer::kFftSize);
+            analyzer.setActive (false);
+            pushSine (analyzer, 5000.0, 1.0f, SpectrumAnalyzer::kFftSize);
+
+            analyzer.setActive (true);
+            expect (! analyzer.process(), "stale samples are dropped");
+
+            float loudest = 0.0f;
+            for (const auto level : analyzer.getLevels())
+                loudest = juce::jmax (loudest, level);
+
+            expectEquals (loudest, 0.0f);
+        }
+
+        beginTest ("Views open and close while the audio thread pushes");
+        {
+            SpectrumAnalyzer analyzer;
+            analyzer.prepare (kSampleRate);
+            std::atomic<bool> running { true };
+
+            std::thread audio ([&]
+            {
+                while (running.load (std::memory_order_relaxed))
+                    pushSine (analyzer, 2000.0, 0.5f, 64, 64);
+            });
+
+            bool inRange = true;
+            const auto endTime = juce::Time::getMillisecondCounter() + 300;
+
+            for (int n = 0; juce::Time::getMillisecondCounter() < endTime; ++n)
+            {
+                analyzer.setActive (n % 8 != 0);
+                analyzer.process();
+
+                for (const auto level : analyzer.getLevels())
+                    inRange = inRange && level >= 0.0f && level <= 1.0f;
+            }
+
+            running = false;
+            audio.join();
+
+            expect (inRange, "levels stay within 0..1");
+            expectGreaterThan (analyzer.getAverageProcessMs(), 0.0);
+        }
+    }
+};
+
+static SpectrumAnalyzerTests spectrumAnalyzerTests;
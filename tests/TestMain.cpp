@@ -0,0 +1,37 @@
+#include <juce_events/juce_events.h>
+#include "Benchmark.h"
+
+//==============================================================================
+/**
+    Runs the juce::UnitTests linked into this app.
+
+        PluginTests                         every category except Benchmarks
+        PluginTests --category <name>       one category, e.g. Benchmarks
+
+    Exits non-zero if any expectation failed or nothing ran.
+*/
+int main (int argc, char* argv[])
+{
+    // Makes this the message thread: timers and ui_core affinity expect one
+    const juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    const juce::StringArray args (argv + 1, argc - 1);
+    const auto categoryArg = args.indexOf ("--category");
+    const auto category = categoryArg >= 0 ? args[categoryArg + 1] : juce::String();
+
+    juce::Array<juce::UnitTest*> tests;
+    for (auto* test : juce::UnitTest::getAllTests())
+        if (category.isNotEmpty() ? test->getCategory() == category
+                                  : test->getCategory() != benchmark::kCategory)
+            tests.add (test);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure (false);
+    runner.runTests (tests);
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult (i)->failures;
+
+    return (failures > 0 || tests.isEmpty()) ? 1 : 0;
+}
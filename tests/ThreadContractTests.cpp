@@ -0,0 +1,176 @@
+#include "ParameterHost.h"
+#include "ControlIds.h"
+#include "hardware/ControlSurface.h"
+#include "hardware/HardwareEventQueue.h"
+#include "hardware/MidiControlDecoder.h"
+#include "SilentOutput.h"
+#include <atomic>
+#include <thread>
+
+//==============================================================================
+/**
+    Drives the plugin's thread-crossing points from the threads that use
+    them in a real session:
+
+    - audio:    MIDI decoding, audio-thread parameter writes, getters
+    - host:     automation writes through HostParameter
+    - hardware: an OSC-style receive thread feeding a HardwareEventQueue
+    - message:  this thread; drains the queue into ControlSurface (bindings,
+                focus, gestures), makes UI edits, undoes/redoes, saves state
+                and notifies the host
+
+    Built for the tsan and asan presets, where a data race, or a ui_core
+    object touched off the message thread, fails the run. Every build also
+    checks that no queued event is lost and that every value stays in range.
+*/
+class ThreadContractStressTest : public juce::UnitTest
+{
+public:
+    ThreadContractStressTest() : juce::UnitTest ("Thread contracts", "Threading") {}
+
+    void runTest() override
+    {
+        beginTest ("Message, audio, host and hardware threads at once");
+
+        Parameters parameters;
+        ParameterHost host (parameters);
+        SilentOutput output;
+        ControlSurface surface (parameters, &output);
+        MidiControlDecoder midiDecoder;
+        HardwareEventQueue hardwareQueue (1024);
+
+        // Fixed before the threads start; learn is exercised elsewhere
+        for (int i = 0; i < kNumControls; ++i)
+            midiDecoder.addMapping (MidiControlDecoder::Kind::cc7, 0, 20 + i, kControls[i].id);
+
+        std::atomic<bool> running { true };
+        std::atomic<int> hardwarePushed { 0 };
+        std::atomic<int> audioBlocks { 0 };
+        std::atomic<int> hostWrites { 0 };
+
+        std::thread audio ([&]
+        {
+            juce::MidiBuffer midi;
+            float sink = 0.0f;
+
+            for (int n = 0; running.load (std::memory_order_relaxed); ++n)
+            {
+                const juce::uint8 cc[] = { 0xb0, static_cast<juce::uint8> (20 + n % kNumControls),
+                                           static_cast<juce::uint8> (n & 0x7f) };
+                midi.clear();
+                midi.addEvent (cc, 3, 0);
+
+                midiDecoder.process (midi, [&] (int, const ui_core::HardwareControlEvent& event)
+                {
+                    const auto index = getHostParameterIndex (event.controlId);
+                    if (index >= 0)
+                        parameters.setNormalisedFromAudioThread (static_cast<Parameters::Index> (index), event.normalizedValue);
+                });
+
+                for (int i = 0; i < Parameters::numHostParameters; ++i)
+                    sink += parameters.getValue (static_cast<Parameters::Index> (i));
+
+                audioBlocks.fetch_add (1, std::memory_order_relaxed);
+            }
+
+            juce::ignoreUnused (sink);
+        });
+
+        std::thread automation ([&]
+        {
+            const auto& hostParameters = host.getParameters();
+
+            for (int n = 0; running.load (std::memory_order_relaxed); ++n)
+            {
+                hostParameters[n % hostParameters.size()]->setValue (static_cast<float> (n % 101) / 100.0f);
+                hostWrites.fetch_add (1, std::memory_order_relaxed);
+            }
+        });
+
+        // Hardware moves the even controls, the UI the odd ones: one source
+        // per control keeps host gestures properly nested.
+        std::thread hardware ([&]
+        {
+            for (int n = 0; running.load (std::memory_order_relaxed); ++n)
+            {
+                const auto& control = kControls[2 * (n % ((kNumControls + 1) / 2))];
+                const ui_core::HardwareControlEvent event { control.id,
+                                                            n % 3 == 0 ? 0.5f : ((n & 1) ? 0.01f : -0.01f),
+                                                            n % 3 != 0 };
+                if (hardwareQueue.push (event))
+                    hardwarePushed.fetch_add (1, std::memory_order_relaxed);
+                else
+                    std::this_thread::yield();
+            }
+        });
+
+        int drained = 0;
+        int messageLoops = 0;
+        auto random = getRandom();
+        const auto endTime = juce::Time::getMillisecondCounter() + kRunMs;
+
+        while (juce::Time::getMillisecondCounter() < endTime)
+        {
+            drained += hardwareQueue.drain ([&] (const ui_core::HardwareControlEvent& event)
+            {
+                surface.getInputAdapter().processEvent (event);
+            });
+
+            const int index = 1 + 2 * random.nextInt (kNumControls / 2);
+            const auto& spec = Parameters::getSpec (kControls[index].parameter);
+            surface.beginGesture (index);
+            surface.setControlValue (index, spec.minValue + random.nextFloat() * (spec.maxValue - spec.minValue));
+            surface.endGesture (index);
+
+            surface.focusControl (random.nextInt (kNumControls));
+
+            if (messageLoops % 8 == 0)   surface.undo();
+            if (messageLoops % 16 == 0)  surface.redo();
+
+            parameters.flushHostNotifications();
+            surface.syncFocusFromParameters();
+
+            juce::ValueTree state ("PluginState");
+            parameters.getState (state);
+            midiDecoder.getState (state);
+            parameters.consumeStateChange();
+
+            ++messageLoops;
+        }
+
+        running = false;
+        audio.join();
+        automation.join();
+        hardware.join();
+
+        drained += hardwareQueue.drain ([&] (const ui_core::HardwareControlEvent& event)
+        {
+            surface.getInputAdapter().processEvent (event);
+        });
+
+        expectEquals (drained, hardwarePushed.load(), "every queued hardware event reaches the bindings");
+
+        for (int i = 0; i < Parameters::numHostParameters; ++i)
+        {
+            const auto index = static_cast<Parameters::Index> (i);
+            const auto& spec = Parameters::getSpec (index);
+            const auto value = parameters.getValue (index);
+            expect (value >= spec.minValue && value <= spec.maxValue, juce::String (spec.id) + " out of range");
+        }
+
+        expect (juce::isPositiveAndBelow (surface.getFocusedIndex(), kNumControls), "focus points at a control");
+        expectGreaterThan (audioBlocks.load(), 0);
+        expectGreaterThan (hostWrites.load(), 0);
+
+        const auto seconds = kRunMs / 1000.0;
+        logMessage ("per second: " + juce::String (audioBlocks.load() / seconds, 0) + " audio blocks, "
+                    + juce::String (hostWrites.load() / seconds, 0) + " host writes, "
+                    + juce::String (drained / seconds, 0) + " hardware events, "
+                    + juce::String (messageLoops / seconds, 0) + " message-thread passes");
+    }
+
+private:
+    static constexpr juce::uint32 kRunMs = 1000;
+};
+
+static ThreadContractStressTest threadContractStressTest;
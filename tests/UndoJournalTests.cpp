@@ -0,0 +1,178 @@
+#include "ParameterHost.h"
+
+//==============================================================================
+/**
+    UndoJournal on its own (gestures, ring overflow, redo invalidation), then
+    through Parameters, whose undo/redo and setState must not feed it.
+*/
+class UndoJournalTests : public juce::UnitTest
+{
+public:
+    UndoJournalTests() : juce::UnitTest ("UndoJournal", "Parameters") {}
+
+    void runTest() override
+    {
+        beginTest ("Edits inside a gesture undo in one step");
+        {
+            UndoJournal journal;
+            journal.beginGesture (0);
+            journal.record (0, 1.0f, 0.9f);
+            journal.record (0, 0.9f, 0.8f);
+            journal.record (0, 0.8f, 0.7f);
+            journal.endGesture (0);
+            journal.record (0, 0.7f, 0.6f);
+
+            expectRecord (journal.undo(), 0, 0.7f, 0.6f);
+            expectRecord (journal.undo(), 0, 1.0f, 0.7f);
+            expect (! journal.canUndo());
+
+            // Another gesture starts a new entry
+            journal.beginGesture (0);
+            journal.record (0, 1.0f, 0.5f);
+            journal.endGesture (0);
+            expectRecord (journal.undo(), 0, 1.0f, 0.5f);
+        }
+
+        beginTest ("A full ring forgets the oldest edit");
+        {
+            UndoJournal journal;
+            constexpr int numEdits = UndoJournal::kCapacity + 44;
+
+            for (int i = 0; i < numEdits; ++i)
+                journal.record (1, static_cast<float> (i), static_cast<float> (i + 1));
+
+            int undone = 0;
+            const UndoJournal::Record* last = nullptr;
+            while (auto* r = journal.undo())
+            {
+                last = r;
+                ++undone;
+            }
+
+            expectEquals (undone, UndoJournal::kCapacity);
+            expectRecord (last, 1, (float) (numEdits - UndoJournal::kCapacity), (float) (numEdits - UndoJournal::kCapacity + 1));
+
+            // The whole ring redoes in order
+            int redone = 0;
+            while (journal.redo() != nullptr)
+                ++redone;
+
+            expectEquals (redone, UndoJournal::kCapacity);
+        }
+
+        beginTest ("A new edit drops what could have been redone");
+        {
+            UndoJournal journal;
+            journal.record (0, 0.0f, 1.0f);
+            journal.record (0, 1.0f, 2.0f);
+            journal.undo();
+            expect (journal.canRedo());
+
+            journal.record (0, 1.0f, 3.0f);
+            expect (! journal.canRedo());
+            expect (journal.redo() == nullptr);
+            expectRecord (journal.undo(), 0, 1.0f, 3.0f);
+        }
+
+        beginTest ("... including one merged into an open gesture");
+        {
+            UndoJournal journal;
+            journal.beginGesture (0);
+            journal.record (0, 0.0f, 1.0f);
+            journal.record (1, 5.0f, 6.0f);
+            journal.undo();
+            expect (journal.canRedo());
+
+            journal.record (0, 1.0f, 2.0f);
+            expect (! journal.canRedo(), "the undone edit of parameter 1 is gone");
+            expect (journal.redo() == nullptr);
+            journal.endGesture (0);
+
+            expectRecord (journal.undo(), 0, 0.0f, 2.0f);
+            expect (! journal.canUndo());
+        }
+
+        beginTest ("Parameters: undo and redo are not journalled");
+        {
+            Parameters parameters;
+            parameters.setGain (0.5f);
+            parameters.setGain (0.7f);
+
+            expectEquals (parameters.undo(), (int) Parameters::gainIndex);
+            expectEquals (parameters.getGain(), 0.5f);
+            expect (parameters.canRedo());
+
+            expectEquals (parameters.undo(), (int) Parameters::gainIndex);
+            expectEquals (parameters.getGain(), 1.0f);
+            expect (! parameters.canUndo());
+            expectEquals (parameters.undo(), -1);
+
+            expectEquals (parameters.redo(), (int) Parameters::gainIndex);
+            expectEquals (parameters.redo(), (int) Parameters::gainIndex);
+            expectEquals (parameters.getGain(), 0.7f);
+            expect (! parameters.canRedo());
+            expectEquals (parameters.redo(), -1);
+        }
+
+        beginTest ("Parameters: audio-thread writes undo one burst at a time");
+        {
+            Parameters parameters;
+            ParameterHost host (parameters);
+            constexpr auto mixBit = 1u << Parameters::mixIndex;
+
+            // A MIDI knob turned across two timer ticks, then left alone
+            parameters.setNormalisedFromAudioThread (Parameters::mixIndex, 0.2f);
+            parameters.setNormalisedFromAudioThread (Parameters::mixIndex, 0.3f);
+            expectEquals ((int) parameters.flushHostNotifications(), (int) mixBit);
+            parameters.setNormalisedFromAudioThread (Parameters::mixIndex, 0.4f);
+            expectEquals ((int) parameters.flushHostNotifications(), (int) mixBit);
+            expectEquals ((int) parameters.flushHostNotifications(), 0, "ends the gesture");
+
+            // And again later
+            parameters.setNormalisedFromAudioThread (Parameters::mixIndex, 0.6f);
+            parameters.flushHostNotifications();
+            parameters.flushHostNotifications();
+
+            expectEquals (parameters.undo(), (int) Parameters::mixIndex);
+            expectEquals (parameters.getMix(), 0.4f);
+            expectEquals (parameters.undo(), (int) Parameters::mixIndex);
+            expectEquals (parameters.getMix(), 1.0f, "the first burst in one step");
+            expect (! parameters.canUndo());
+
+            // Undoing is not an audio-thread write: nothing to catch up on
+            expectEquals ((int) parameters.flushHostNotifications(), 0);
+            expect (parameters.canRedo());
+        }
+
+        beginTest ("Parameters: setState starts a fresh history");
+        {
+            Parameters parameters;
+            parameters.setGain (0.3f);
+            parameters.setMix (0.4f);
+            parameters.undo();
+            expect (parameters.canUndo() && parameters.canRedo());
+
+            juce::ValueTree state ("state");
+            state.setProperty ("gain", 1.5f, nullptr);
+            parameters.setState (state);
+
+            expectEquals (parameters.getGain(), 1.5f);
+            expect (! parameters.canUndo());
+            expect (! parameters.canRedo());
+        }
+    }
+
+private:
+    void expectRecord (const UndoJournal::Record* r, int parameterIndex, float oldValue, float newValue)
+    {
+        expect (r != nullptr);
+        if (r == nullptr)
+            return;
+
+        expectEquals (r->parameterIndex, parameterIndex);
+        expectEquals (r->oldValue, oldValue);
+        expectEquals (r->newValue, newValue);
+    }
+};
+
+static UndoJournalTests undoJournalTests;
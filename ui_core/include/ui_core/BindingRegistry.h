@@ -1,38 +1,49 @@
 #pragma once
 
 #include "ParameterBinding.h"
+#include "ThreadAffinity.h"
 #include <unordered_map>
 
 namespace ui_core
 {
 
+/**
+    Thread contract: message thread only. Bindings call into UI and host
+    notification code, so other threads (audio, OSC, MIDI) must queue their
+    events and let the message thread apply them.
+*/
 class BindingRegistry
 {
 public:
     void add (ParameterBinding binding)
     {
+        thread.check();
         bindings[binding.controlId] = std::move (binding);
     }
 
     ParameterBinding* find (ControlId id)
     {
+        thread.check();
         auto it = bindings.find (id);
         return it != bindings.end() ? &it->second : nullptr;
     }
 
     const ParameterBinding* find (ControlId id) const
     {
+        thread.check();
         auto it = bindings.find (id);
         return it != bindings.end() ? &it->second : nullptr;
     }
 
     void clear()
     {
+        thread.check();
         bindings.clear();
     }
 
 private:
     std::unordered_map<ControlId, ParameterBinding> bindings;
+    ThreadAffinity thread;
 };
 
 }
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "ControlId.h"
+#include "HardwareAdapters.h"
+#include "ThreadAffinity.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace ui_core
+{
+
+/** Fixed-size display line; never allocates. */
+using DisplayText = std::array<char, kDisplayTextCapacity>;
+
+/** "<value><suffix>" into a fixed buffer, truncated to fit. */
+inline void formatDisplayValue (DisplayText& dest, float value, int decimals, const char* suffix = "") noexcept
+{
+    std::snprintf (dest.data(), dest.size(), "%.*f%s", decimals, static_cast<double> (value), suffix);
+}
+
+/** Copies text into a fixed buffer, truncated to fit. The rest is zeroed,
+    so two buffers compare equal exactly when their text does. */
+inline void copyDisplayText (DisplayText& dest, const char* text) noexcept
+{
+    std::size_t length = 0;
+    if (text != nullptr)
+        while (length < dest.size() - 1 && text[length] != '\0')
+            ++length;
+
+    std::copy_n (text, length, dest.begin());
+    std::fill (dest.begin() + static_cast<std::ptrdiff_t> (length), dest.end(), '\0');
+}
+
+/**
+    Sends display text to a HardwareOutputAdapter, only when it changed and
+    at most once per minIntervalMs per display.
+
+    setText() stages a line; flush() sends staged lines that differ from
+    what the device last got. Text lives in fixed per-line buffers, so after
+    addDisplay() nothing here allocates. Surfaces on slow links (MIDI SysEx,
+    serial) only see the characters that actually changed screens.
+
+    Thread contract: message thread only.
+*/
+class DisplayDriver
+{
+public:
+    DisplayDriver (HardwareOutputAdapter& outputToUse, std::uint32_t minIntervalMsToUse)
+        : output (outputToUse), minIntervalMs (minIntervalMsToUse)
+    {
+    }
+
+    /** Setup only: may allocate. */
+    void addDisplay (ControlId displayId)
+    {
+        thread.check();
+
+        const auto it = std::lower_bound (displays.begin(), displays.end(), displayId,
+                                          [] (const Display& d, ControlId id) { return d.id < id; });
+        if (it == displays.end() || it->id != displayId)
+            displays.insert (it, Display { displayId });
+    }
+
+    /** Stages one line. Returns false for an unknown display or line. */
+    bool setText (ControlId displayId, int line, const char* text) noexcept
+    {
+        thread.check();
+
+        auto* display = find (displayId);
+        if (display == nullptr || line < 0 || line >= kDisplayLines)
+            return false;
+
+        copyDisplayText (display->lines[(size_t) line].pending, text);
+        return true;
+    }
+
+    /** Sends changed lines of every display whose interval has elapsed. */
+    void flush (std::uint32_t nowMs)
+    {
+        thread.check();
+
+        for (auto& display : displays)
+        {
+            if (display.everSent && nowMs - display.lastSentMs < minIntervalMs)
+                continue;
+
+            bool sent = false;
+            for (int line = 0; line < kDisplayLines; ++line)
+            {
+                auto& l = display.lines[(size_t) line];
+                if (display.everSent && l.pending == l.sent)
+                    continue;
+
+                output.setDisplayText (display.id, line, l.pending.data());
+                l.sent = l.pending;
+                sent = true;
+            }
+
+            if (sent)
+            {
+                display.lastSentMs = nowMs;
+                display.everSent = true;
+            }
+        }
+    }
+
+    /** Forget what the device shows (e.g. after a reconnect): the next
+        flush() sends every line again. */
+    void invalidate() noexcept
+    {
+        thread.check();
+
+        for (auto& display : displays)
+            display.everSent = false;
+    }
+
+private:
+    struct Line
+    {
+        DisplayText pending {};
+        DisplayText sent {};
+    };
+
+    struct Display
+    {
+        ControlId id {};
+        std::uint32_t lastSentMs = 0;
+        bool everSent = false;
+        std::array<Line, kDisplayLines> lines {};
+    };
+
+    Display* find (ControlId displayId) noexcept
+    {
+        const auto it = std::lower_bound (displays.begin(), displays.end(), displayId,
+                                          [] (const Display& d, ControlId id) { return d.id < id; });
+        return it != displays.end() && it->id == displayId ? &*it : nullptr;
+    }
+
+    HardwareOutputAdapter& output;
+    const std::uint32_t minIntervalMs;
+    std::vector<Display> displays;     // sorted by id
+    ThreadAffinity thread;
+};
+
+}
@@ -2,17 +2,23 @@
 
 #include "ControlId.h"
 #include "Focus.h"
+#include "ThreadAffinity.h"
 #include <optional>
 #include <unordered_map>
 
 namespace ui_core
 {
 
+/**
+    Thread contract: message thread only. Focusable callbacks repaint UI.
+*/
 class FocusManager
 {
 public:
     void setFocusedControl (std::optional<ControlId> controlId)
     {
+        thread.check();
+
         // Clear focus on old widget
         if (focusedControlId.has_value())
         {
@@ -34,17 +40,20 @@ public:
 
     std::optional<ControlId> getFocusedControl() const
     {
+        thread.check();
         return focusedControlId;
     }
 
     void registerWidget (ControlId controlId, Focusable* widget)
     {
+        thread.check();
         if (widget != nullptr)
             widgets[controlId] = widget;
     }
 
     void unregisterWidget (ControlId controlId, Focusable* widget)
     {
+        thread.check();
         auto it = widgets.find (controlId);
         if (it != widgets.end() && it->second == widget)
             widgets.erase (it);
@@ -53,6 +62,7 @@ public:
 private:
     std::optional<ControlId> focusedControlId;
     std::unordered_map<ControlId, Focusable*> widgets;
+    ThreadAffinity thread;
 };
 
 }
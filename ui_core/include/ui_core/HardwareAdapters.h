@@ -19,6 +19,13 @@ public:
     virtual ~HardwareOutputAdapter() = default;
     virtual void setLEDValue (ControlId controlId, float normalized) = 0;
     virtual void setFocus (ControlId controlId, bool focused) = 0;
+
+    // Optional: text for a Display control. text is NUL-terminated, shorter
+    // than kDisplayTextCapacity and only valid during the call.
+    virtual void setDisplayText (ControlId displayId, int line, const char* text)
+    {
+        (void) displayId; (void) line; (void) text;
+    }
 };
 
 }
@@ -15,6 +15,12 @@ enum class HardwareControlType
     Display
 };
 
+// Display text: fixed buffers, NUL included. Longer text is truncated.
+constexpr int kDisplayTextCapacity = 32;
+constexpr int kDisplayNameLine  = 0;
+constexpr int kDisplayValueLine = 1;
+constexpr int kDisplayLines     = 2;
+
 struct HardwareControlEvent
 {
     ControlId controlId{};
@@ -14,6 +14,10 @@ struct ParameterBinding
     std::function<float(float)> toNative;
     std::function<float(float)> toNormalized;
 
+    // Optional: bracket a continuous edit (drag, encoder burst) for the host.
+    std::function<void()> onGestureBegin;
+    std::function<void()> onGestureEnd;
+
     void set (float normalizedValue)
     {
         if (setNormalized)
@@ -36,6 +40,18 @@ struct ParameterBinding
         else
             return nativeValue;
     }
+
+    void beginGesture()
+    {
+        if (onGestureBegin)
+            onGestureBegin();
+    }
+
+    void endGesture()
+    {
+        if (onGestureEnd)
+            onGestureEnd();
+    }
 };
 
 inline ParameterBinding makeBinding (ControlId id,
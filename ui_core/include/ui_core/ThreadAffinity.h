@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <thread>
+
+namespace ui_core
+{
+
+/**
+    Debug-only guard for objects that must stay on one thread.
+
+    The first call to check() claims the calling thread; any later call from
+    another thread asserts. Compiles to nothing when NDEBUG is defined.
+    Call release() to hand the object over to another thread on purpose.
+*/
+class ThreadAffinity
+{
+public:
+    ThreadAffinity() = default;
+    ThreadAffinity (const ThreadAffinity&) noexcept {}
+    ThreadAffinity& operator= (const ThreadAffinity&) noexcept { return *this; }
+
+    void check() const noexcept
+    {
+       #ifndef NDEBUG
+        const auto self = std::this_thread::get_id();
+        auto expected = std::thread::id();
+        if (! owner.compare_exchange_strong (expected, self))
+            assert (expected == self && "ui_core object used from more than one thread");
+       #endif
+    }
+
+    void release() noexcept
+    {
+        owner.store (std::thread::id());
+    }
+
+private:
+    mutable std::atomic<std::thread::id> owner {};
+};
+
+}
@@ -3,7 +3,9 @@
 #include "ControlId.h"
 #include "HardwareContract.h"
 #include "HardwareAdapters.h"
+#include "DisplayDriver.h"
 #include "Focus.h"
 #include "FocusManager.h"
 #include "ParameterBinding.h"
 #include "BindingRegistry.h"
+#include "ThreadAffinity.h"